@@ -0,0 +1,365 @@
+#!/usr/bin/env python3
+
+"""Adaptive sweep over scenario_coex options, driven by a Gaussian-process surrogate.
+
+The sweep space is a grid (--grid option=value,value,...). Every pass reads the structured
+results (scratch/results/<job>.jsonl) of the jobs emitted so far, fits a Gaussian process to
+one metric over the grid and picks the next batch where the surrogate is most uncertain or
+changes fastest, i.e. around the anomaly boundary rather than on flat plateaus. Jobs still
+running count as observations at their predicted value, so consecutive batches do not pile up
+on the same spot.
+
+Without --run a pass writes the batch as JSON lines ({"name": ..., "args": [...]}) to
+<sweep dir>/batch_NNN.jsonl for any executor; with --run the driver simulates the batches
+itself until --budget jobs have run.
+
+    python3 adaptive_sweep.py --name ampdu_sta --grid beMaxAmpdu=0,65535,262144,1048576,4194304 \\
+        --grid modernStaCount=1,2,4,6,10 --grid modernDataMode=HeMcs0,HeMcs3,HeMcs7,HeMcs11 \\
+        --base-args="--legacyStandard=a --modernStandard=ax --simulationTime=60" --run --budget 40 -j 8
+"""
+
+from __future__ import annotations
+
+import argparse
+import hashlib
+import itertools
+import json
+import math
+import os
+import shlex
+import subprocess
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Optional
+
+METRICS = {
+    "fairness": "Jain's fairness index over the per-STA throughputs",
+    "total_throughput": "sum of all STA throughputs (Mbit/s)",
+    "legacy_throughput": "mean throughput of a legacy STA (Mbit/s)",
+    "modern_throughput": "mean throughput of a modern STA (Mbit/s)",
+    "legacy_airtime": "mean airtime of a legacy STA (%)",
+}
+
+LENGTH_SCALES = [0.1, 0.2, 0.35, 0.5, 0.75, 1.0]
+NOISE_VARIANCE = 1e-2  # relative to the normalised metric variance
+
+
+@dataclass
+class Dimension:
+    option: str
+    values: list[str]
+
+
+def parse_grid(specs: list[str]) -> list[Dimension]:
+    dimensions = []
+    for spec in specs:
+        option, _, values = spec.partition("=")
+        items = [value.strip() for value in values.split(",") if value.strip()]
+        if not option or len(items) < 2:
+            raise SystemExit(f"--grid {spec!r}: expected option=value,value[,...]")
+        dimensions.append(Dimension(option, items))
+    return dimensions
+
+
+def job_for(point: tuple[int, ...], dimensions: list[Dimension], args: argparse.Namespace) -> dict:
+    """Job of a grid point; its name is stable, so results of earlier passes are found again."""
+    options = [f"--{dim.option}={dim.values[index]}" for dim, index in zip(dimensions, point)]
+    digest = hashlib.sha1(" ".join(options + [args.base_args]).encode()).hexdigest()[:10]
+    name = f"{args.name}_{digest}"
+    return {"name": name, "args": [f"--scenario={name}", *shlex.split(args.base_args), *options]}
+
+
+def metric_value(record: dict, metric: str) -> Optional[float]:
+    flows = record.get("flows", [])
+    throughputs = [float(flow["throughput_mbps"]) for flow in flows]
+    legacy = [flow for flow in flows if flow.get("bss") == "legacy"]
+    modern = [flow for flow in flows if flow.get("bss") == "modern"]
+    if metric == "fairness":
+        squares = sum(value * value for value in throughputs)
+        return sum(throughputs) ** 2 / (len(throughputs) * squares) if squares > 0 else None
+    if metric == "total_throughput":
+        return sum(throughputs) if throughputs else None
+    group = legacy if metric.startswith("legacy") else modern
+    field = "airtime_pct" if metric.endswith("airtime") else "throughput_mbps"
+    values = [float(flow[field]) for flow in group if flow.get(field) is not None]
+    return sum(values) / len(values) if values else None
+
+
+def read_result(results_dir: Path, name: str, metric: str) -> Optional[float]:
+    path = results_dir / f"{name}.jsonl"
+    try:
+        lines = path.read_text(encoding="utf-8").splitlines()
+        return metric_value(json.loads(lines[-1]), metric) if lines else None
+    except (OSError, ValueError, KeyError):
+        return None
+
+
+def cholesky(matrix: list[list[float]]) -> list[list[float]]:
+    n = len(matrix)
+    lower = [[0.0] * n for _ in range(n)]
+    for i in range(n):
+        for j in range(i + 1):
+            total = matrix[i][j] - sum(lower[i][k] * lower[j][k] for k in range(j))
+            if i == j:
+                lower[i][i] = math.sqrt(max(total, 1e-12))
+            else:
+                lower[i][j] = total / lower[j][j]
+    return lower
+
+
+def solve_lower(lower: list[list[float]], b: list[float]) -> list[float]:
+    x = []
+    for i, row in enumerate(lower):
+        x.append((b[i] - sum(row[k] * x[k] for k in range(i))) / row[i])
+    return x
+
+
+def solve_upper_transposed(lower: list[list[float]], b: list[float]) -> list[float]:
+    n = len(lower)
+    x = [0.0] * n
+    for i in reversed(range(n)):
+        x[i] = (b[i] - sum(lower[k][i] * x[k] for k in range(i + 1, n))) / lower[i][i]
+    return x
+
+
+class GaussianProcess:
+    """Zero-mean GP with a squared-exponential kernel on normalised inputs and outputs."""
+
+    def __init__(self, inputs: list[list[float]], outputs: list[float]):
+        self.mean = sum(outputs) / len(outputs)
+        spread = math.sqrt(sum((y - self.mean) ** 2 for y in outputs) / len(outputs))
+        self.scale = spread if spread > 1e-12 else 1.0
+        self.inputs = inputs
+        targets = [(y - self.mean) / self.scale for y in outputs]
+        best = None
+        for length in LENGTH_SCALES:
+            lower, alpha = self._factor(length, targets)
+            # log marginal likelihood without the constant term
+            likelihood = -0.5 * sum(t * a for t, a in zip(targets, alpha)) - sum(
+                math.log(lower[i][i]) for i in range(len(lower))
+            )
+            if best is None or likelihood > best[0]:
+                best = (likelihood, length, lower, alpha)
+        _, self.length, self.lower, self.alpha = best
+
+    def _kernel(self, a: list[float], b: list[float], length: float) -> float:
+        return math.exp(-sum((x - y) ** 2 for x, y in zip(a, b)) / (2 * length * length))
+
+    def _factor(self, length: float, targets: list[float]):
+        n = len(self.inputs)
+        matrix = [
+            [self._kernel(self.inputs[i], self.inputs[j], length) + (NOISE_VARIANCE if i == j else 0.0) for j in range(n)]
+            for i in range(n)
+        ]
+        lower = cholesky(matrix)
+        return lower, solve_upper_transposed(lower, solve_lower(lower, targets))
+
+    def predict(self, point: list[float]) -> tuple[float, float]:
+        """Mean in metric units and standard deviation in normalised units."""
+        k = [self._kernel(point, x, self.length) for x in self.inputs]
+        mean = sum(a * b for a, b in zip(k, self.alpha))
+        v = solve_lower(self.lower, k)
+        variance = max(1.0 - sum(value * value for value in v), 0.0)
+        return self.mean + self.scale * mean, math.sqrt(variance)
+
+
+def coordinates(point: tuple[int, ...], dimensions: list[Dimension]) -> list[float]:
+    """Grid position scaled to [0, 1] per dimension, so log-spaced and categorical grids work alike."""
+    return [index / (len(dim.values) - 1) for index, dim in zip(point, dimensions)]
+
+
+def neighbours(point: tuple[int, ...], dimensions: list[Dimension]):
+    for axis, dim in enumerate(dimensions):
+        for step in (-1, 1):
+            index = point[axis] + step
+            if 0 <= index < len(dim.values):
+                yield point[:axis] + (index,) + point[axis + 1 :]
+
+
+def initial_design(candidates: list[tuple[int, ...]], chosen: list[tuple[int, ...]], count: int, dimensions) -> list:
+    """Greedy maximin points, starting from the grid centre: spread out before anything is known."""
+    picked = []
+    taken = [coordinates(point, dimensions) for point in chosen]
+    if not taken:
+        centre = min(candidates, key=lambda p: sum((x - 0.5) ** 2 for x in coordinates(p, dimensions)))
+        picked.append(centre)
+        taken.append(coordinates(centre, dimensions))
+    remaining = [point for point in candidates if point not in picked]
+    while len(picked) < count and remaining:
+        best = max(
+            remaining,
+            key=lambda p: min(sum((a - b) ** 2 for a, b in zip(coordinates(p, dimensions), t)) for t in taken),
+        )
+        picked.append(best)
+        taken.append(coordinates(best, dimensions))
+        remaining.remove(best)
+    return picked
+
+
+def select_batch(
+    observed: dict[tuple[int, ...], float],
+    pending: list[tuple[int, ...]],
+    grid: list[tuple[int, ...]],
+    candidates: list[tuple[int, ...]],
+    dimensions: list[Dimension],
+    batch: int,
+    gradient_weight: float,
+) -> tuple[list[tuple[int, ...]], Optional[GaussianProcess]]:
+    """Highest std + gradient_weight * steepest step to a grid neighbour, with pending and
+    already picked points believed at their predicted value."""
+    points = list(observed)
+    values = [observed[point] for point in points]
+    model = GaussianProcess([coordinates(p, dimensions) for p in points], values)
+    believed = list(pending)
+    picked: list[tuple[int, ...]] = []
+    while len(picked) < batch:
+        if believed:
+            predictions = [model.predict(coordinates(p, dimensions))[0] for p in believed]
+            surrogate = GaussianProcess(
+                [coordinates(p, dimensions) for p in points + believed], values + predictions
+            )
+        else:
+            surrogate = model
+        open_points = [p for p in candidates if p not in picked]
+        if not open_points:
+            break
+        estimates = {p: surrogate.predict(coordinates(p, dimensions)) for p in grid}
+
+        def score(point):
+            mean, deviation = estimates[point]
+            steepest = max((abs(estimates[n][0] - mean) for n in neighbours(point, dimensions)), default=0.0)
+            return deviation + gradient_weight * steepest / surrogate.scale
+
+        best = max(open_points, key=score)
+        picked.append(best)
+        believed.append(best)
+    return picked, model
+
+
+def run_batch(jobs: list[dict], project_root: Path, workers: int) -> None:
+    def run(job: dict) -> None:
+        log_dir = project_root / "scratch" / "logs"
+        log_dir.mkdir(parents=True, exist_ok=True)
+        with (log_dir / f"{job['name']}.log").open("w", encoding="utf-8") as log:
+            command = [str(project_root / "ns3"), "run", "--no-build", "scenario_coex", "--", *job["args"]]
+            returncode = subprocess.run(command, cwd=project_root, stdout=log, stderr=subprocess.STDOUT).returncode
+        status = "ok" if returncode == 0 else f"FAILED (exit {returncode})"
+        print(f"  [{status}] {job['name']}", flush=True)
+
+    with ThreadPoolExecutor(max_workers=workers) as pool:
+        list(pool.map(run, jobs))
+
+
+def build_parser() -> argparse.ArgumentParser:
+    script_dir = Path(__file__).resolve().parent
+    parser = argparse.ArgumentParser(description="Pick the next scenario_coex runs with a Gaussian-process surrogate.")
+    parser.add_argument("--name", required=True, help="Sweep name; prefixes the job names")
+    parser.add_argument(
+        "--grid",
+        action="append",
+        required=True,
+        help="scenario_coex option and its values, e.g. beMaxAmpdu=0,65535,4194304 (repeat per dimension)",
+    )
+    parser.add_argument("--base-args", default="", help="Options passed to every job, e.g. \"--legacyStandard=n\"")
+    parser.add_argument("--metric", choices=sorted(METRICS), default="fairness", help="Metric the surrogate models")
+    parser.add_argument("--batch", type=int, default=8, help="Jobs per batch (default: %(default)s)")
+    parser.add_argument(
+        "--initial",
+        type=int,
+        help="Space-filling jobs before the surrogate is used (default: 2 * dimensions + 1, at least --batch)",
+    )
+    parser.add_argument(
+        "--gradient-weight",
+        type=float,
+        default=1.0,
+        help="Weight of the steepest change to a grid neighbour against the uncertainty (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--sweep-dir",
+        type=Path,
+        help="Directory with the sweep state and batch files (default: scratch/sweeps/<name>)",
+    )
+    parser.add_argument("--project-root", type=Path, default=script_dir, help="ns-3 root (default: %(default)s)")
+    parser.add_argument("--results", type=Path, help="Result records (default: <project root>/scratch/results)")
+    parser.add_argument("--run", action="store_true", help="Simulate the batches instead of only writing them")
+    parser.add_argument("--budget", type=int, default=0, help="With --run: stop after this many jobs (0: whole grid)")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1, help="With --run: parallel simulations")
+    parser.add_argument("--predictions", type=Path, help="Write the surrogate mean and std of every grid point as CSV")
+    return parser
+
+
+def main() -> None:
+    args = build_parser().parse_args()
+    dimensions = parse_grid(args.grid)
+    project_root = args.project_root.resolve()
+    results_dir = args.results or project_root / "scratch" / "results"
+    sweep_dir = args.sweep_dir or project_root / "scratch" / "sweeps" / args.name
+    sweep_dir.mkdir(parents=True, exist_ok=True)
+    state_path = sweep_dir / "state.json"
+    state = json.loads(state_path.read_text(encoding="utf-8")) if state_path.exists() else {"emitted": [], "batches": 0}
+    emitted = {tuple(point) for point in state["emitted"]}
+
+    candidates = list(itertools.product(*(range(len(dim.values)) for dim in dimensions)))
+    budget = args.budget or len(candidates)
+    initial = max(args.initial or 2 * len(dimensions) + 1, 1)
+
+    while True:
+        observed: dict[tuple[int, ...], float] = {}
+        pending = []
+        for point in sorted(emitted):
+            value = read_result(results_dir, job_for(point, dimensions, args)["name"], args.metric)
+            if value is None:
+                pending.append(point)
+            else:
+                observed[point] = value
+        open_points = [point for point in candidates if point not in emitted]
+        size = min(args.batch, len(open_points))
+        if args.run:
+            size = min(size, budget - len(emitted))
+
+        model = None
+        if size <= 0:
+            points = []
+        elif len(observed) < min(initial, len(candidates)) or len(observed) < 2:
+            points = initial_design(open_points, sorted(emitted), size, dimensions)
+        else:
+            points, model = select_batch(
+                observed, pending, candidates, open_points, dimensions, size, args.gradient_weight
+            )
+        if model is None and len(observed) >= 2:
+            model = GaussianProcess([coordinates(p, dimensions) for p in observed], list(observed.values()))
+
+        print(
+            f"{args.name}: {len(observed)} results, {len(pending)} pending, {len(open_points)} of "
+            f"{len(candidates)} grid points never run"
+            + (f"; surrogate length scale {model.length:g}" if model else "")
+        )
+        if args.predictions and model:
+            lines = [",".join([dim.option for dim in dimensions] + [args.metric, "std", "observed"])]
+            for point in candidates:
+                mean, deviation = model.predict(coordinates(point, dimensions))
+                values = [dim.values[index] for dim, index in zip(dimensions, point)]
+                actual = observed.get(point)
+                lines.append(
+                    ",".join(values + [f"{mean:.6g}", f"{deviation * model.scale:.6g}", "" if actual is None else f"{actual:.6g}"])
+                )
+            args.predictions.write_text("\n".join(lines) + "\n", encoding="utf-8")
+        if not points:
+            break
+
+        jobs = [job_for(point, dimensions, args) for point in points]
+        state["batches"] += 1
+        batch_path = sweep_dir / f"batch_{state['batches']:03d}.jsonl"
+        batch_path.write_text("".join(json.dumps(job) + "\n" for job in jobs), encoding="utf-8")
+        emitted.update(points)
+        state["emitted"] = [list(point) for point in sorted(emitted)]
+        state_path.write_text(json.dumps(state) + "\n", encoding="utf-8")
+        print(f"Wrote {len(jobs)} jobs to {batch_path}")
+        if not args.run:
+            break
+        run_batch(jobs, project_root, args.jobs)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,13 +1,22 @@
 #!/usr/bin/env python3
 
-"""Aggregate ns-3 simulation log metrics into CSV reports."""
+"""Aggregate ns-3 simulation results into CSV reports.
+
+Structured records written by scenario_coex (scratch/results/*.jsonl) are used when present;
+runs without one fall back to parsing the human-readable log.
+"""
 
 from __future__ import annotations
 
 import argparse
 import csv
+import hashlib
+import json
+import os
 import re
 import statistics
+import time
+from concurrent.futures import ProcessPoolExecutor
 from dataclasses import dataclass
 from pathlib import Path
 from typing import Iterable, Optional, Tuple
@@ -188,6 +197,103 @@ def summarize_airtime(
     return legacy_mean, ax_mean, ax_max, be_mean, be_max
 
 
+def build_entry(
+    scenario: str,
+    legacy_standard: Optional[str],
+    legacy_metrics: Optional[Metrics],
+    ax_network_metrics: Optional[Metrics],
+    ax_station_metrics: list[Metrics],
+    be_network_metrics: Optional[Metrics],
+    be_station_metrics: list[Metrics],
+    airtime: tuple[Optional[float], Optional[float], Optional[float], Optional[float], Optional[float]],
+) -> Optional[ParsedEntry]:
+    if not (legacy_metrics or ax_network_metrics or ax_station_metrics or be_network_metrics or be_station_metrics):
+        return None
+
+    ax_mean, ax_max = aggregate_metrics(ax_network_metrics, ax_station_metrics)
+    be_mean, be_max = aggregate_metrics(be_network_metrics, be_station_metrics)
+    (
+        legacy_airtime_pct,
+        ax_airtime_avg_pct,
+        ax_airtime_max_pct,
+        be_airtime_avg_pct,
+        be_airtime_max_pct,
+    ) = airtime
+
+    return ParsedEntry(
+        scenario=scenario,
+        legacy_standard=f"802.11{legacy_standard}" if legacy_standard else None,
+        legacy_metrics=legacy_metrics,
+        ax_mean=ax_mean,
+        ax_max=ax_max,
+        be_mean=be_mean,
+        be_max=be_max,
+        legacy_airtime_pct=legacy_airtime_pct,
+        ax_airtime_avg_pct=ax_airtime_avg_pct,
+        ax_airtime_max_pct=ax_airtime_max_pct,
+        be_airtime_avg_pct=be_airtime_avg_pct,
+        be_airtime_max_pct=be_airtime_max_pct,
+    )
+
+
+def parse_result(result_path: Path) -> Optional[ParsedEntry]:
+    """Build an entry from the last record of a scenario_coex results file."""
+    with result_path.open("r", encoding="utf-8") as result_file:
+        records = [line for line in result_file if line.strip()]
+    if not records:
+        return None
+    record = json.loads(records[-1])
+
+    legacy_standard: Optional[str] = None
+    legacy_metrics: Optional[Metrics] = None
+    ax_metrics: list[Metrics] = []
+    be_metrics: list[Metrics] = []
+    legacy_airtime: list[float] = []
+    ax_airtime: list[float] = []
+    be_airtime: list[float] = []
+
+    for flow in record.get("flows", []):
+        standard = flow["standard"]
+        metrics = Metrics(
+            throughput_mbps=float(flow["throughput_mbps"]),
+            delay_ms=float(flow["delay_ms"]),
+            jitter_ms=float(flow["jitter_ms"]),
+        )
+        airtime_pct = flow.get("airtime_pct")
+        if standard == "ax":
+            ax_metrics.append(metrics)
+            target = ax_airtime
+        elif standard == "be":
+            be_metrics.append(metrics)
+            target = be_airtime
+        elif standard in LEGACY_STANDARDS:
+            legacy_standard = standard
+            legacy_metrics = metrics
+            target = legacy_airtime
+        else:
+            continue
+        if airtime_pct is not None:
+            target.append(float(airtime_pct))
+
+    airtime = (
+        statistics.fmean(legacy_airtime) if legacy_airtime else None,
+        statistics.fmean(ax_airtime) if ax_airtime else None,
+        max(ax_airtime) if ax_airtime else None,
+        statistics.fmean(be_airtime) if be_airtime else None,
+        max(be_airtime) if be_airtime else None,
+    )
+    return build_entry(
+        record.get("scenario", result_path.stem),
+        legacy_standard,
+        legacy_metrics,
+        None,
+        ax_metrics,
+        None,
+        be_metrics,
+        airtime,
+    )
+
+
 def parse_log(log_path: Path) -> Optional[ParsedEntry]:
     legacy_standard: Optional[str] = None
     legacy_metrics: Optional[Metrics] = None
@@ -241,35 +347,17 @@ def parse_log(log_path: Path) -> Optional[ParsedEntry]:
                 legacy_standard = standard
                 legacy_metrics = metrics
 
-    if not (legacy_metrics or ax_network_metrics or ax_station_metrics or be_network_metrics or be_station_metrics):
-        return None
-
-    ax_mean, ax_max = aggregate_metrics(ax_network_metrics, ax_station_metrics)
-    be_mean, be_max = aggregate_metrics(be_network_metrics, be_station_metrics)
-
     has_ax = bool(ax_network_metrics or ax_station_metrics)
     has_be = bool(be_network_metrics or be_station_metrics)
-    (
-        legacy_airtime_pct,
-        ax_airtime_avg_pct,
-        ax_airtime_max_pct,
-        be_airtime_avg_pct,
-        be_airtime_max_pct,
-    ) = summarize_airtime(airtime_entries, has_ax, has_be)
-
-    return ParsedEntry(
-        scenario=log_path.stem,
-        legacy_standard=f"802.11{legacy_standard}" if legacy_standard else None,
-        legacy_metrics=legacy_metrics,
-        ax_mean=ax_mean,
-        ax_max=ax_max,
-        be_mean=be_mean,
-        be_max=be_max,
-        legacy_airtime_pct=legacy_airtime_pct,
-        ax_airtime_avg_pct=ax_airtime_avg_pct,
-        ax_airtime_max_pct=ax_airtime_max_pct,
-        be_airtime_avg_pct=be_airtime_avg_pct,
-        be_airtime_max_pct=be_airtime_max_pct,
+    return build_entry(
+        log_path.stem,
+        legacy_standard,
+        legacy_metrics,
+        ax_network_metrics,
+        ax_station_metrics,
+        be_network_metrics,
+        be_station_metrics,
+        summarize_airtime(airtime_entries, has_ax, has_be),
     )
 
 
@@ -315,47 +403,220 @@ def entry_for_legacy_be(parsed: ParsedEntry) -> Optional[dict]:
     }
 
 
-def aggregate_logs(log_dir: Path) -> tuple[list[dict], list[dict]]:
-    legacy_ax_entries: list[dict] = []
-    legacy_be_entries: list[dict] = []
+def collect_inputs(log_dir: Path, results_dir: Optional[Path]) -> list[Path]:
+    """One input per scenario: its results record if there is one, otherwise its log."""
+    inputs: dict[str, Path] = {}
+    if log_dir.exists():
+        for log_path in log_dir.glob("*.log"):
+            if log_path.is_file():
+                inputs[log_path.stem] = log_path
+    if results_dir is not None and results_dir.exists():
+        for result_path in results_dir.glob("*.jsonl"):
+            if result_path.is_file():
+                inputs[result_path.stem] = result_path
+    return [inputs[name] for name in sorted(inputs)]
 
-    for log_path in sorted(log_dir.glob("*.log")):
-        if not log_path.is_file():
-            continue
-        parsed = parse_log(log_path)
-        if not parsed:
+
+def parse_input(path: Path) -> Optional[ParsedEntry]:
+    return parse_result(path) if path.suffix == ".jsonl" else parse_log(path)
+
+
+@dataclass
+class IngestedInput:
+    path: Path
+    mtime_ns: int
+    size: int
+    sha256: str
+    parsed: Optional[ParsedEntry]
+
+
+def file_sha256(path: Path) -> str:
+    digest = hashlib.sha256()
+    with path.open("rb") as input_file:
+        for chunk in iter(lambda: input_file.read(1 << 20), b""):
+            digest.update(chunk)
+    return digest.hexdigest()
+
+
+def ingest_input(path: Path, known_sha256: Optional[str]) -> IngestedInput:
+    """Fingerprint one input and parse it unless its content is already known.
+
+    Runs in a worker process; a file whose hash matches the previous ingestion (e.g. a log
+    restored from the cache with a new mtime) is not parsed again.
+    """
+    stat = path.stat()
+    sha256 = file_sha256(path)
+    parsed = parse_input(path) if sha256 != known_sha256 else None
+    return IngestedInput(path, stat.st_mtime_ns, stat.st_size, sha256, parsed)
+
+
+class IngestState:
+    """Inputs that already have rows in the output CSVs, keyed by path."""
+
+    def __init__(self, path: Path, outputs: list[Path]):
+        self.path = path
+        self.outputs = [str(output) for output in outputs]
+        self.inputs: dict[str, dict] = {}
+        if not path.exists():
+            return
+        with path.open("r", encoding="utf-8") as state_file:
+            data = json.load(state_file)
+        # Rows only exist while the CSVs they were appended to exist.
+        if data.get("outputs") == self.outputs and all(Path(output).exists() for output in self.outputs):
+            self.inputs = data.get("inputs", {})
+
+    def is_current(self, path: Path) -> bool:
+        known = self.inputs.get(str(path))
+        if known is None:
+            return False
+        stat = path.stat()
+        return known["mtime_ns"] == stat.st_mtime_ns and known["size"] == stat.st_size
+
+    def known_sha256(self, path: Path) -> Optional[str]:
+        known = self.inputs.get(str(path))
+        return known["sha256"] if known else None
+
+    def record(self, ingested: IngestedInput) -> None:
+        self.inputs[str(ingested.path)] = {
+            "mtime_ns": ingested.mtime_ns,
+            "size": ingested.size,
+            "sha256": ingested.sha256,
+        }
+
+    def save(self) -> None:
+        tmp_path = self.path.with_name(self.path.name + ".tmp")
+        with tmp_path.open("w", encoding="utf-8") as state_file:
+            json.dump({"outputs": self.outputs, "inputs": self.inputs}, state_file, indent=1, sort_keys=True)
+        os.replace(tmp_path, self.path)
+
+
+def pending_inputs(inputs: list[Path], state: IngestState, settle_seconds: float) -> list[Path]:
+    """Inputs that are new or changed and have not been modified for settle_seconds."""
+    now = time.time()
+    pending = []
+    for path in inputs:
+        try:
+            if state.is_current(path):
+                continue
+            if now - path.stat().st_mtime < settle_seconds:
+                continue
+        except FileNotFoundError:
             continue
+        pending.append(path)
+    return pending
+
+
+def ingest(
+    inputs: list[Path],
+    state: IngestState,
+    jobs: int,
+) -> list[ParsedEntry]:
+    """Parse the given inputs in parallel and record them in the state.
+
+    Inputs without results yet (e.g. the log of a run that is still going) are left
+    unrecorded so that a later pass picks them up.
+    """
+    entries: list[ParsedEntry] = []
+    if not inputs:
+        return entries
+
+    known = [state.known_sha256(path) for path in inputs]
+    if jobs > 1 and len(inputs) > 1:
+        with ProcessPoolExecutor(max_workers=jobs) as executor:
+            results = list(executor.map(ingest_input, inputs, known, chunksize=max(1, len(inputs) // (jobs * 4))))
+    else:
+        results = [ingest_input(path, sha256) for path, sha256 in zip(inputs, known)]
 
-        ax_entry = entry_for_legacy_ax(parsed)
-        if ax_entry:
-            legacy_ax_entries.append(ax_entry)
+    for path, sha256, ingested in zip(inputs, known, results):
+        if ingested.sha256 == sha256:
+            state.record(ingested)
+        elif ingested.parsed is not None:
+            state.record(ingested)
+            entries.append(ingested.parsed)
+    entries.sort(key=lambda entry: entry.scenario)
+    return entries
 
-        be_entry = entry_for_legacy_be(parsed)
-        if be_entry:
-            legacy_be_entries.append(be_entry)
 
-    return legacy_ax_entries, legacy_be_entries
+def add_rows(parsed: ParsedEntry, legacy_ax_entries: list[dict], legacy_be_entries: list[dict]) -> None:
+    ax_entry = entry_for_legacy_ax(parsed)
+    if ax_entry:
+        legacy_ax_entries.append(ax_entry)
 
+    be_entry = entry_for_legacy_be(parsed)
+    if be_entry:
+        legacy_be_entries.append(be_entry)
 
-def write_csv(entries: list[dict], output_path: Path, fieldnames: list[str]) -> None:
-    if not entries:
-        return
 
-    with output_path.open("w", newline="", encoding="utf-8") as csvfile:
+def append_csv(entries: list[dict], output_path: Path, fieldnames: list[str]) -> None:
+    """Append rows, writing the header first if the file is new or empty."""
+    write_header = not output_path.exists() or output_path.stat().st_size == 0
+    with output_path.open("a", newline="", encoding="utf-8") as csvfile:
         writer = csv.DictWriter(csvfile, fieldnames=fieldnames)
-        writer.writeheader()
+        if write_header:
+            writer.writeheader()
         for entry in entries:
             writer.writerow(entry)
+        csvfile.flush()
+        os.fsync(csvfile.fileno())
+
+
+def merge_csv(entries: list[dict], output_path: Path, fieldnames: list[str]) -> None:
+    """Rewrite the CSV with one row per scenario, the new rows replacing the older ones."""
+    rows: dict[str, dict] = {}
+    if output_path.exists():
+        with output_path.open("r", newline="", encoding="utf-8") as csvfile:
+            for row in csv.DictReader(csvfile):
+                rows[row["scenario"]] = row
+    for entry in entries:
+        rows[entry["scenario"]] = entry
+
+    tmp_path = output_path.with_name(output_path.name + ".tmp")
+    with tmp_path.open("w", newline="", encoding="utf-8") as csvfile:
+        writer = csv.DictWriter(csvfile, fieldnames=fieldnames)
+        writer.writeheader()
+        for scenario in sorted(rows):
+            writer.writerow(rows[scenario])
+        csvfile.flush()
+        os.fsync(csvfile.fileno())
+    os.replace(tmp_path, output_path)
+
+
+def run_pass(args: argparse.Namespace, state: IngestState, settle_seconds: float) -> tuple[int, int]:
+    inputs = pending_inputs(collect_inputs(args.logs, args.results), state, settle_seconds)
+    legacy_ax_entries: list[dict] = []
+    legacy_be_entries: list[dict] = []
+    for parsed in ingest(inputs, state, args.jobs):
+        add_rows(parsed, legacy_ax_entries, legacy_be_entries)
+
+    # Rows reach the CSVs before the state marks their inputs as ingested, so an interrupted
+    # pass can at worst ingest them again, never lose them.
+    write_csv = append_csv if args.append else merge_csv
+    if legacy_ax_entries:
+        write_csv(legacy_ax_entries, args.out_legacy_ax, LEGACY_AX_FIELDS)
+    if legacy_be_entries:
+        write_csv(legacy_be_entries, args.out_legacy_be, LEGACY_BE_FIELDS)
+    state.save()
+    return len(legacy_ax_entries), len(legacy_be_entries)
 
 
 def build_parser() -> argparse.ArgumentParser:
-    parser = argparse.ArgumentParser(description="Aggregate ns-3 log metrics into CSV files.")
+    parser = argparse.ArgumentParser(
+        description="Aggregate ns-3 log metrics into CSV files.",
+        epilog="Each pass only parses new or changed inputs and keeps one row per scenario, so a "
+        "re-run scenario replaces its older row. Use --rebuild to start over.",
+    )
     parser.add_argument(
         "--logs",
         type=Path,
         default=Path(__file__).resolve().parent / "logs",
         help="Directory containing ns-3 log files (default: %(default)s)",
     )
+    parser.add_argument(
+        "--results",
+        type=Path,
+        default=Path(__file__).resolve().parent / "scratch" / "results",
+        help="Directory containing scenario_coex *.jsonl result records (default: %(default)s)",
+    )
     parser.add_argument(
         "--out",
         dest="out_legacy_ax",
@@ -376,6 +637,47 @@ def build_parser() -> argparse.ArgumentParser:
         default=Path("aggregated_legacy_be.csv"),
         help="Path to the legacy-vs-be CSV file (default: %(default)s)",
     )
+    parser.add_argument(
+        "--state",
+        type=Path,
+        default=Path("aggregated_state.json"),
+        help="File tracking the already ingested inputs (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--rebuild",
+        action="store_true",
+        help="Discard the state and the CSV files and ingest everything again.",
+    )
+    parser.add_argument(
+        "--append",
+        action="store_true",
+        help="Append the new rows instead of rewriting the CSVs; a re-run scenario then gets a "
+        "second row after the older one.",
+    )
+    parser.add_argument(
+        "-j",
+        "--jobs",
+        type=int,
+        default=os.cpu_count() or 1,
+        help="Number of parser processes (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--watch",
+        action="store_true",
+        help="Keep running and ingest runs as they finish (stop with Ctrl-C).",
+    )
+    parser.add_argument(
+        "--interval",
+        type=float,
+        default=10.0,
+        help="Seconds between passes in watch mode (default: %(default)s)",
+    )
+    parser.add_argument(
+        "--settle",
+        type=float,
+        default=5.0,
+        help="In watch mode, skip inputs modified less than this many seconds ago (default: %(default)s)",
+    )
     return parser
 
 
@@ -384,22 +686,37 @@ def main() -> None:
     args = parser.parse_args()
 
     log_dir: Path = args.logs
-    if not log_dir.exists():
-        raise SystemExit(f"Log directory not found: {log_dir}")
-
-    legacy_ax_entries, legacy_be_entries = aggregate_logs(log_dir)
-
-    if legacy_ax_entries:
-        write_csv(legacy_ax_entries, args.out_legacy_ax, LEGACY_AX_FIELDS)
-        print(f"Wrote {len(legacy_ax_entries)} rows to {args.out_legacy_ax}")
-    else:
-        print("No legacy vs 802.11ax results found; skipping CSV generation.")
+    results_dir: Path = args.results
+    if not args.watch and not log_dir.exists() and not results_dir.exists():
+        raise SystemExit(f"Neither {log_dir} nor {results_dir} exists")
+
+    if args.rebuild:
+        for path in (args.state, args.out_legacy_ax, args.out_legacy_be):
+            path.unlink(missing_ok=True)
+    state = IngestState(args.state, [args.out_legacy_ax, args.out_legacy_be])
+
+    if not args.watch:
+        ax_rows, be_rows = run_pass(args, state, settle_seconds=0.0)
+        verb = "Appended" if args.append else "Updated"
+        if ax_rows:
+            print(f"{verb} {ax_rows} rows in {args.out_legacy_ax}")
+        else:
+            print("No new legacy vs 802.11ax results found.")
+        if be_rows:
+            print(f"{verb} {be_rows} rows in {args.out_legacy_be}")
+        else:
+            print("No new legacy vs 802.11be results found.")
+        return
 
-    if legacy_be_entries:
-        write_csv(legacy_be_entries, args.out_legacy_be, LEGACY_BE_FIELDS)
-        print(f"Wrote {len(legacy_be_entries)} rows to {args.out_legacy_be}")
-    else:
-        print("No legacy vs 802.11be results found; skipping CSV generation.")
+    print(f"Watching {log_dir} and {results_dir} every {args.interval:g} s (Ctrl-C to stop)")
+    try:
+        while True:
+            ax_rows, be_rows = run_pass(args, state, args.settle)
+            if ax_rows or be_rows:
+                print(f"Wrote {ax_rows} legacy vs 802.11ax and {be_rows} legacy vs 802.11be rows", flush=True)
+            time.sleep(args.interval)
+    except KeyboardInterrupt:
+        pass
 
 
 if __name__ == "__main__":
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Analytical pre-screening of scenario_coex configurations.
+ *
+ * Takes the same scenario options as scenario_coex (--scenario presets and the BSS, channel
+ * and A-MPDU overrides; the simulation-only options are accepted and ignored, so a sweep's
+ * argument list can be passed unchanged) and prints the per-STA throughput and airtime estimated by the
+ * Bianchi-style AnomalyModel (helpers/anomaly-model.h) instead of simulating. Runs in
+ * microseconds, so sweeps can skip uninteresting regions and simulation results can be
+ * cross-checked.
+ *
+ *   ./ns3 run anomaly_predictor -- --scenario=scenario_coex_n_be_decsta --beMaxAmpdu=4194304
+ *   ./ns3 run anomaly_predictor -- --legacyStandard=ac --modernStandard=be --modernStaCount=6 --json=1
+ */
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+#include "../helpers/anomaly-model.h"
+#include "../helpers/scenario-presets.h"
+
+using namespace ns3;
+
+namespace
+{
+
+// scenario_coex options that do not affect the model; keep in sync with its CommandLine.
+const char* const g_simulationOnlyOptions[] = {
+    "channelCache", "radius", "netAnim", "pcap", "legacyAssoc", "arpCache", "pcapSnapLen",
+    "pcapHeaderOnly", "pcapStart", "pcapDuration", "pcapMaxFileSize", "pcapMaxFiles",
+    "flowmonFormat", "sampleInterval", "scheduler", "eventProfile", "traceLevel", "traceWindow",
+    "simulationTime", "stack", "traffic", "clientInterval", "backlogThreshold", "warmup",
+    "convergence", "convergenceBatch", "convergencePrecision", "convergenceMinBatches",
+    "branchTime", "branchParameter", "branchValues", "branchParallel", "replications", "parallel",
+};
+
+// Channel width and band from a ChannelSettings string such as "{36, 20, BAND_5GHZ, 0}".
+void
+ParseChannelSettings(const std::string& settings, AnomalyModel::Parameters& parameters)
+{
+    std::string text = settings;
+    for (char& c : text)
+    {
+        if (c == '{' || c == '}' || c == ',')
+        {
+            c = ' ';
+        }
+    }
+    std::istringstream fields(text);
+    std::string channel;
+    std::string width;
+    std::string band;
+    fields >> channel >> width >> band;
+    if (!width.empty() && std::stod(width) > 0.0)
+    {
+        parameters.channelWidth = std::stod(width);
+    }
+    parameters.band2_4GHz = band == "BAND_2_4GHZ";
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    std::string name = FindScenarioArgument(argc, argv, "scenario_coex_a_ax");
+    const ScenarioPreset* preset = FindPreset(name);
+    if (!preset)
+    {
+        preset = FindPreset("scenario_coex_a_ax");
+    }
+    std::string legacyStandard = preset->legacyStandard;
+    uint32_t legacyStaCount = preset->legacyStaCount;
+    std::string legacyDataMode;
+    std::string legacyControlMode;
+    std::string modernStandard = preset->modernStandard;
+    uint32_t modernStaCount = preset->modernStaCount;
+    std::string modernDataMode = preset->modernDataMode;
+    std::string modernControlMode = preset->modernControlMode;
+    std::string channelSettings = "{36, 20, BAND_5GHZ, 0}";
+    uint32_t beMaxAmpdu = 0;
+    uint32_t payloadSize = 1472;
+    double heGuardInterval = 3200; // ns
+    bool json = false;
+
+    CommandLine cmd;
+    cmd.AddValue("scenario", "Preset name (e.g. scenario_coex_a_ax_decsta); also labels the output", name);
+    cmd.AddValue("legacyStandard", "Standard of the legacy BSS (a, n, ac, ax, be)", legacyStandard);
+    cmd.AddValue("legacyStaCount", "Number of STAs in the legacy BSS (0 disables it)", legacyStaCount);
+    cmd.AddValue("legacyDataMode", "Legacy data mode (empty: default for the standard)", legacyDataMode);
+    cmd.AddValue("legacyControlMode", "Legacy control mode (empty: default for the standard)", legacyControlMode);
+    cmd.AddValue("modernStandard", "Standard of the modern BSS (a, n, ac, ax, be)", modernStandard);
+    cmd.AddValue("modernStaCount", "Number of STAs in the modern BSS", modernStaCount);
+    cmd.AddValue("modernDataMode", "Modern data mode (empty: default for the standard)", modernDataMode);
+    cmd.AddValue("modernControlMode", "Modern control mode (empty: default for the standard)", modernControlMode);
+    cmd.AddValue("channelSettings", "PHY ChannelSettings shared by both BSSs", channelSettings);
+    cmd.AddValue("beMaxAmpdu", "Maximum A-MPDU size for BE traffic (bytes, 0 disables aggregation)", beMaxAmpdu);
+    cmd.AddValue("payloadSize", "UDP payload per packet (bytes)", payloadSize);
+    cmd.AddValue("heGuardInterval", "Guard interval of HE/EHT data symbols (ns)", heGuardInterval);
+    cmd.AddValue("json", "Print one JSON record instead of text", json);
+    std::map<std::string, std::string> ignored;
+    for (const char* option : g_simulationOnlyOptions)
+    {
+        cmd.AddValue(option, "scenario_coex option, ignored here", ignored[option]);
+    }
+    cmd.Parse(argc, argv);
+
+    AnomalyModel::Parameters parameters;
+    ParseChannelSettings(channelSettings, parameters);
+    parameters.maxAmpduBytes = beMaxAmpdu;
+    parameters.payloadBytes = payloadSize;
+    parameters.heGuardInterval = heGuardInterval * 1e-9;
+    const bool sameStandard = legacyStaCount > 0 && legacyStandard == modernStandard;
+    for (const bool legacy : {true, false})
+    {
+        AnomalyModel::Bss bss;
+        bss.standard = legacy ? legacyStandard : modernStandard;
+        bss.staCount = legacy ? legacyStaCount : modernStaCount;
+        bss.dataMode = legacy ? legacyDataMode : modernDataMode;
+        bss.controlMode = legacy ? legacyControlMode : modernControlMode;
+        if (bss.staCount == 0)
+        {
+            continue;
+        }
+        auto [dataMode, controlMode] = DefaultModes(bss.standard);
+        bss.dataMode = bss.dataMode.empty() ? dataMode : bss.dataMode;
+        bss.controlMode = bss.controlMode.empty() ? controlMode : bss.controlMode;
+        bss.label = "802.11" + bss.standard + (sameStandard && legacy ? " network 1" : "");
+        parameters.bsses.push_back(bss);
+    }
+
+    const AnomalyModel::Prediction prediction = AnomalyModel::Predict(parameters);
+
+    if (json)
+    {
+        std::cout << std::setprecision(10) << "{\"scenario\":\"" << name << "\",\"tau\":" << prediction.tau
+                  << ",\"collision_probability\":" << prediction.collisionProbability
+                  << ",\"mean_slot_us\":" << prediction.meanSlot * 1e6 << ",\"idle_share\":" << prediction.idleShare
+                  << ",\"success_share\":" << prediction.successShare
+                  << ",\"collision_share\":" << prediction.collisionShare
+                  << ",\"total_throughput_mbps\":" << prediction.TotalThroughput() << ",\"bss\":[";
+        for (size_t i = 0; i < prediction.bsses.size(); ++i)
+        {
+            const AnomalyModel::StationPrediction& bss = prediction.bsses[i];
+            std::cout << (i ? "," : "") << "{\"label\":\"" << bss.label << "\",\"standard\":\"" << bss.standard
+                      << "\",\"data_mode\":\"" << bss.dataMode << "\",\"sta_count\":" << bss.staCount
+                      << ",\"mpdus_per_ppdu\":" << bss.mpdusPerPpdu
+                      << ",\"ppdu_duration_us\":" << bss.ppduDuration * 1e6
+                      << ",\"throughput_mbps\":" << bss.throughput << ",\"airtime_pct\":" << bss.airtime * 100
+                      << "}";
+        }
+        std::cout << "]}" << std::endl;
+        return 0;
+    }
+
+    std::cout << "Predicted (Bianchi model) for " << name << ": tau " << prediction.tau
+              << ", collision probability " << prediction.collisionProbability << ", channel idle "
+              << prediction.idleShare * 100 << "%, successes " << prediction.successShare * 100
+              << "%, collisions " << prediction.collisionShare * 100 << "%" << std::endl;
+    for (const AnomalyModel::StationPrediction& bss : prediction.bsses)
+    {
+        std::cout << bss.label << " (" << bss.staCount << (bss.staCount > 1 ? " STAs" : " STA") << ", "
+                  << bss.dataMode << ", " << bss.mpdusPerPpdu << " MPDUs in " << bss.ppduDuration * 1e6
+                  << " us) - Throughput per STA: " << bss.throughput << " Mbit/s, airtime per STA: "
+                  << bss.airtime * 100 << "%" << std::endl;
+    }
+    std::cout << "Total throughput: " << prediction.TotalThroughput() << " Mbit/s" << std::endl;
+    return 0;
+}
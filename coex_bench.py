@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+
+"""coex-bench: performance regression check over a representative set of scenario_coex presets.
+
+Every preset runs for a short, fixed simulated time with tracing off and a fixed RngRun, in its
+own working directory (scratch/bench/<preset>), so the regular results are not touched. Wall
+time, events per second and peak RSS are taken from the "profile" object of the structured
+result and compared against a stored baseline; a metric that is worse than the baseline by more
+than the tolerance fails the suite.
+
+    python3 coex_bench.py                    # compare against coex_bench_baseline.json
+    python3 coex_bench.py --update-baseline  # record a new baseline (e.g. after an ns-3 upgrade)
+    python3 coex_bench.py --schedulers       # events per second of every --scheduler, no baseline
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import platform
+import subprocess
+import sys
+import time
+from pathlib import Path
+from typing import Optional
+
+SUITE = [
+    "scenario_single_ax",
+    "scenario_coex_a_ax",
+    "scenario_coex_n_be_decsta",
+    "scenario_coex_be_11sta",
+]
+
+# Saturated presets with the heaviest event load, for choosing the simulator scheduler.
+SCHEDULER_SUITE = [
+    "scenario_coex_a_ax_decsta",
+    "scenario_coex_be_11sta",
+]
+
+SCHEDULERS = ["map", "heap", "calendar", "list"]
+
+# Metric name, whether larger is better.
+METRICS = [
+    ("wall_s", False),
+    ("events_per_s", True),
+    ("peak_rss_kb", False),
+]
+
+
+def run_preset(project_root: Path, preset: str, args: argparse.Namespace, scheduler: str = "map") -> dict:
+    """Run one preset args.repeat times and keep the fastest run (the least disturbed one)."""
+    work_dir = project_root / "scratch" / "bench" / preset
+    work_dir.mkdir(parents=True, exist_ok=True)
+    command = [
+        str(project_root / "ns3"),
+        "run",
+        "--no-build",
+        f"--cwd={work_dir}",
+        "scenario_coex",
+        "--",
+        f"--scenario={preset}",
+        f"--simulationTime={args.simulation_time}",
+        "--traceLevel=none",
+        f"--RngRun={args.rng_run}",
+        f"--scheduler={scheduler}",
+    ]
+    best: Optional[dict] = None
+    for _ in range(args.repeat):
+        started = time.monotonic()
+        completed = subprocess.run(command, cwd=project_root, capture_output=True, text=True)
+        process_s = time.monotonic() - started
+        if completed.returncode != 0:
+            sys.stderr.write(completed.stdout + completed.stderr)
+            raise RuntimeError(f"{preset} exited with {completed.returncode}")
+        record_path = work_dir / "scratch" / "results" / f"{preset}.jsonl"
+        lines = record_path.read_text(encoding="utf-8").splitlines()
+        profile = json.loads(lines[-1])["profile"]
+        measurement = {
+            "wall_s": profile["setup_s"] + profile["run_s"],
+            "process_s": process_s,
+            "events": profile["events"],
+            "events_per_s": profile["events_per_s"],
+            "sim_s_per_wall_s": profile["sim_s_per_wall_s"],
+            "peak_rss_kb": profile["peak_rss_kb"],
+        }
+        if best is None or measurement["wall_s"] < best["wall_s"]:
+            best = measurement
+    assert best is not None
+    return best
+
+
+def compare(preset: str, current: dict, baseline: Optional[dict], tolerance: float) -> list[str]:
+    """Print one line per metric and return the regressions."""
+    regressions = []
+    if baseline is None:
+        print(f"  {preset}: no baseline")
+        return regressions
+    for name, higher_is_better in METRICS:
+        reference = baseline.get(name)
+        if not reference:
+            continue
+        change = current[name] / reference - 1.0
+        worse = -change if higher_is_better else change
+        status = "REGRESSION" if worse > tolerance else "ok"
+        print(f"  {preset} {name}: {current[name]:.6g} (baseline {reference:.6g}, {change:+.1%}) {status}")
+        if worse > tolerance:
+            regressions.append(f"{preset} {name} {change:+.1%}")
+    if baseline.get("events") not in (None, current["events"]):
+        # Same preset, seed and duration: a different event count means the model changed, so
+        # the timing comparison is not like for like.
+        print(f"  {preset} events: {current['events']} (baseline {baseline['events']}), the simulation itself changed")
+    return regressions
+
+
+def compare_schedulers(project_root: Path, presets: list[str], args: argparse.Namespace) -> dict:
+    """Run every preset under every scheduler and print events per second, fastest first."""
+    report: dict = {}
+    print(f"Events per second by scheduler ({args.simulation_time:g} simulated s, best of {args.repeat} runs):")
+    for preset in presets:
+        measurements = {scheduler: run_preset(project_root, preset, args, scheduler) for scheduler in SCHEDULERS}
+        report[preset] = measurements
+        ranking = sorted(SCHEDULERS, key=lambda name: measurements[name]["events_per_s"], reverse=True)
+        fastest = measurements[ranking[0]]["events_per_s"]
+        print(f"  {preset}:")
+        for scheduler in ranking:
+            measurement = measurements[scheduler]
+            print(
+                f"    {scheduler:<9} {measurement['events_per_s']:>12.0f} events/s"
+                f" ({measurement['events_per_s'] / fastest - 1.0:+.1%}), {measurement['wall_s']:.2f} s,"
+                f" {measurement['peak_rss_kb'] / 1024:.0f} MB"
+            )
+        if len({measurement["events"] for measurement in measurements.values()}) > 1:
+            # The schedulers keep equal-time events in FIFO order, so the runs must be identical.
+            print(f"    event counts differ between schedulers: {[m['events'] for m in measurements.values()]}")
+    return report
+
+
+def build_parser() -> argparse.ArgumentParser:
+    script_dir = Path(__file__).resolve().parent
+    parser = argparse.ArgumentParser(description="Run the coex-bench performance regression suite.")
+    parser.add_argument(
+        "--project-root",
+        type=Path,
+        default=script_dir,
+        help="ns-3 root containing the ns3 script (default: the directory of this script)",
+    )
+    parser.add_argument(
+        "--baseline",
+        type=Path,
+        default=script_dir / "coex_bench_baseline.json",
+        help="Stored baseline (default: coex_bench_baseline.json next to this script)",
+    )
+    parser.add_argument("--update-baseline", action="store_true", help="Write the measurements as the new baseline")
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.15,
+        help="Allowed relative slowdown or growth per metric before the suite fails (default: 0.15)",
+    )
+    parser.add_argument("--simulation-time", type=float, default=5.0, help="Simulated seconds per preset")
+    parser.add_argument("--rng-run", type=int, default=1, help="RngRun used for every preset")
+    parser.add_argument("--repeat", type=int, default=3, help="Runs per preset; the fastest one counts")
+    parser.add_argument("--only", nargs="+", choices=SUITE + SCHEDULER_SUITE, help="Run only these presets")
+    parser.add_argument(
+        "--schedulers",
+        action="store_true",
+        help=f"Compare the schedulers ({', '.join(SCHEDULERS)}) on {', '.join(SCHEDULER_SUITE)} instead",
+    )
+    parser.add_argument("--report", type=Path, help="Also write the measurements to this JSON file")
+    parser.add_argument("--no-build", action="store_true", help="Do not build scenario_coex first")
+    return parser
+
+
+def main() -> None:
+    args = build_parser().parse_args()
+    if args.repeat < 1:
+        raise SystemExit("--repeat must be at least 1")
+    if args.schedulers and args.update_baseline:
+        raise SystemExit("--schedulers does not record a baseline")
+    project_root = args.project_root.resolve()
+    if not args.no_build:
+        subprocess.run([str(project_root / "ns3"), "build", "scenario_coex"], cwd=project_root, check=True)
+
+    baseline: dict = {}
+    if args.baseline.exists():
+        stored = json.loads(args.baseline.read_text(encoding="utf-8"))
+        if stored.get("simulation_time") != args.simulation_time or stored.get("rng_run") != args.rng_run:
+            print(f"Baseline {args.baseline} was recorded with different settings; not comparing")
+        else:
+            baseline = stored.get("presets", {})
+
+    if args.schedulers:
+        report = compare_schedulers(project_root, args.only or SCHEDULER_SUITE, args)
+        if args.report:
+            result = {
+                "simulation_time": args.simulation_time,
+                "rng_run": args.rng_run,
+                "host": platform.node(),
+                "recorded": time.strftime("%Y-%m-%dT%H:%M:%S"),
+                "schedulers": report,
+            }
+            args.report.write_text(json.dumps(result, indent=2) + "\n", encoding="utf-8")
+        return
+
+    measurements = {}
+    regressions = []
+    for preset in args.only or SUITE:
+        measurements[preset] = run_preset(project_root, preset, args)
+        if not args.update_baseline:
+            regressions += compare(preset, measurements[preset], baseline.get(preset), args.tolerance)
+
+    result = {
+        "simulation_time": args.simulation_time,
+        "rng_run": args.rng_run,
+        "host": platform.node(),
+        "recorded": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        "presets": measurements,
+    }
+    if args.report:
+        args.report.write_text(json.dumps(result, indent=2) + "\n", encoding="utf-8")
+    if args.update_baseline:
+        if args.only and baseline:
+            result["presets"] = {**baseline, **measurements}
+        args.baseline.write_text(json.dumps(result, indent=2) + "\n", encoding="utf-8")
+        print(f"Wrote baseline for {len(measurements)} presets to {args.baseline}")
+        return
+
+    if regressions:
+        print(f"{len(regressions)} regressions beyond {args.tolerance:.0%}: {', '.join(regressions)}")
+        sys.exit(1)
+    print(f"coex-bench: {len(measurements)} presets within {args.tolerance:.0%} of the baseline")
+
+
+if __name__ == "__main__":
+    main()
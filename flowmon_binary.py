@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+
+"""Read binary FlowMonitor exports written by the scenario helpers.
+
+*.fmb (helpers/flowmon-binary.h): read_flowmon() returns one FlowRecord per flow; as a tool
+the export is converted to the FlowMonitor XML layout, without histograms or probes.
+*.fts (helpers/flow-sampler.h): read_timeseries() returns the per-flow time series; as a
+tool they are converted to CSV with one row per sample and flow.
+
+    python3 flowmon_binary.py scratch/flowmon/scenario_coex_a_ax.fmb -o scenario_coex_a_ax.flowmon
+    python3 flowmon_binary.py scratch/timeseries/scenario_coex_a_ax.fts
+"""
+
+from __future__ import annotations
+
+import argparse
+import ipaddress
+import struct
+import sys
+from dataclasses import dataclass, fields
+from pathlib import Path
+from typing import BinaryIO
+from xml.sax.saxutils import quoteattr
+
+MAGIC = b"NS3FLOWM"
+VERSION = 1
+TIMESERIES_MAGIC = b"NS3FTSER"
+TIMESERIES_COLUMNS = [
+    ("rx_bytes", "Q"),
+    ("rx_packets", "I"),
+    ("tx_packets", "I"),
+    ("delay_sum_ns", "q"),
+    ("lost_packets", "I"),
+]
+
+# Column name and struct format, in file order.
+COLUMNS = [
+    ("flow_id", "I"),
+    ("source_address", "I"),
+    ("destination_address", "I"),
+    ("protocol", "B"),
+    ("source_port", "H"),
+    ("destination_port", "H"),
+    ("time_first_tx_ns", "q"),
+    ("time_first_rx_ns", "q"),
+    ("time_last_tx_ns", "q"),
+    ("time_last_rx_ns", "q"),
+    ("delay_sum_ns", "q"),
+    ("jitter_sum_ns", "q"),
+    ("last_delay_ns", "q"),
+    ("tx_bytes", "Q"),
+    ("rx_bytes", "Q"),
+    ("tx_packets", "I"),
+    ("rx_packets", "I"),
+    ("lost_packets", "I"),
+    ("times_forwarded", "I"),
+]
+
+
+@dataclass
+class FlowRecord:
+    flow_id: int
+    source_address: str
+    destination_address: str
+    protocol: int
+    source_port: int
+    destination_port: int
+    time_first_tx_ns: int
+    time_first_rx_ns: int
+    time_last_tx_ns: int
+    time_last_rx_ns: int
+    delay_sum_ns: int
+    jitter_sum_ns: int
+    last_delay_ns: int
+    tx_bytes: int
+    rx_bytes: int
+    tx_packets: int
+    rx_packets: int
+    lost_packets: int
+    times_forwarded: int
+
+
+def read_columns(stream: BinaryIO) -> dict[str, tuple]:
+    """Return every column as a tuple of N values, keyed by column name."""
+    header = stream.read(16)
+    if len(header) != 16 or header[:8] != MAGIC:
+        raise ValueError("not a binary FlowMonitor export")
+    version, column_count, flow_count = struct.unpack("<HHI", header[8:])
+    if version != VERSION or column_count != len(COLUMNS):
+        raise ValueError(f"unsupported export version {version} with {column_count} columns")
+
+    columns: dict[str, tuple] = {}
+    for name, fmt in COLUMNS:
+        size = struct.calcsize(fmt) * flow_count
+        data = stream.read(size)
+        if len(data) != size:
+            raise ValueError(f"truncated export in column {name}")
+        columns[name] = struct.unpack(f"<{flow_count}{fmt}", data)
+    return columns
+
+
+def read_flowmon(path: Path) -> list[FlowRecord]:
+    with path.open("rb") as stream:
+        columns = read_columns(stream)
+    records = []
+    for values in zip(*(columns[name] for name, _ in COLUMNS)):
+        row = dict(zip((name for name, _ in COLUMNS), values))
+        row["source_address"] = str(ipaddress.IPv4Address(row["source_address"]))
+        row["destination_address"] = str(ipaddress.IPv4Address(row["destination_address"]))
+        records.append(FlowRecord(**row))
+    return records
+
+
+@dataclass
+class TimeSeries:
+    interval_ns: int
+    times_ns: tuple[int, ...]
+    # flow id -> column name -> one value per sample
+    flows: dict[int, dict[str, tuple[int, ...]]]
+
+
+def read_timeseries(path: Path) -> TimeSeries:
+    with path.open("rb") as stream:
+        data = stream.read()
+    if data[:8] != TIMESERIES_MAGIC:
+        raise ValueError("not a flow time-series dump")
+    version, _, flow_count, sample_count, interval_ns = struct.unpack_from("<HHIIq", data, 8)
+    if version != 1:
+        raise ValueError(f"unsupported time-series version {version}")
+    offset = 28
+    flow_ids = struct.unpack_from(f"<{flow_count}I", data, offset)
+    offset += 4 * flow_count
+    times_ns = struct.unpack_from(f"<{sample_count}q", data, offset)
+    offset += 8 * sample_count
+    flows: dict[int, dict[str, tuple[int, ...]]] = {}
+    for flow_id in flow_ids:
+        columns = {}
+        for name, fmt in TIMESERIES_COLUMNS:
+            columns[name] = struct.unpack_from(f"<{sample_count}{fmt}", data, offset)
+            offset += struct.calcsize(fmt) * sample_count
+        flows[flow_id] = columns
+    return TimeSeries(interval_ns, times_ns, flows)
+
+
+def timeseries_to_csv(series: TimeSeries) -> str:
+    names = [name for name, _ in TIMESERIES_COLUMNS]
+    lines = [",".join(["time_s", "flow_id"] + names)]
+    for index, time_ns in enumerate(series.times_ns):
+        for flow_id, columns in series.flows.items():
+            values = [str(columns[name][index]) for name in names]
+            lines.append(",".join([f"{time_ns / 1e9:.9g}", str(flow_id)] + values))
+    return "\n".join(lines) + "\n"
+
+
+def format_time(nanoseconds: int) -> str:
+    return f"{'+' if nanoseconds >= 0 else '-'}{abs(nanoseconds)}.0ns"
+
+
+def to_xml(records: list[FlowRecord]) -> str:
+    lines = ['<?xml version="1.0" ?>', "<FlowMonitor>", "  <FlowStats>"]
+    for record in records:
+        attributes = {
+            "flowId": record.flow_id,
+            "timeFirstTxPacket": format_time(record.time_first_tx_ns),
+            "timeFirstRxPacket": format_time(record.time_first_rx_ns),
+            "timeLastTxPacket": format_time(record.time_last_tx_ns),
+            "timeLastRxPacket": format_time(record.time_last_rx_ns),
+            "delaySum": format_time(record.delay_sum_ns),
+            "jitterSum": format_time(record.jitter_sum_ns),
+            "lastDelay": format_time(record.last_delay_ns),
+            "txBytes": record.tx_bytes,
+            "rxBytes": record.rx_bytes,
+            "txPackets": record.tx_packets,
+            "rxPackets": record.rx_packets,
+            "lostPackets": record.lost_packets,
+            "timesForwarded": record.times_forwarded,
+        }
+        rendered = " ".join(f"{key}={quoteattr(str(value))}" for key, value in attributes.items())
+        lines.append(f"    <Flow {rendered}>")
+        lines.append("    </Flow>")
+    lines.append("  </FlowStats>")
+    lines.append("  <Ipv4FlowClassifier>")
+    for record in records:
+        lines.append(
+            f'    <Flow flowId="{record.flow_id}" sourceAddress="{record.source_address}"'
+            f' destinationAddress="{record.destination_address}" protocol="{record.protocol}"'
+            f' sourcePort="{record.source_port}" destinationPort="{record.destination_port}">'
+        )
+        lines.append("    </Flow>")
+    lines.append("  </Ipv4FlowClassifier>")
+    lines.append("</FlowMonitor>")
+    return "\n".join(lines) + "\n"
+
+
+def build_parser() -> argparse.ArgumentParser:
+    parser = argparse.ArgumentParser(
+        description="Convert a binary FlowMonitor export to FlowMonitor XML, or a flow time series to CSV."
+    )
+    parser.add_argument("input", type=Path, help="Binary export (*.fmb) or time-series dump (*.fts)")
+    parser.add_argument(
+        "-o",
+        "--output",
+        type=Path,
+        help="Output file (default: the input with the .flowmon or .csv extension, '-' for stdout)",
+    )
+    parser.add_argument("--csv", action="store_true", help="Write CSV with one row per flow instead of XML")
+    return parser
+
+
+def main() -> None:
+    args = build_parser().parse_args()
+    if args.input.suffix == ".fts":
+        series = read_timeseries(args.input)
+        text = timeseries_to_csv(series)
+        output = args.output or args.input.with_suffix(".csv")
+        if str(output) == "-":
+            sys.stdout.write(text)
+        else:
+            output.write_text(text, encoding="utf-8")
+            print(f"Wrote {len(series.times_ns)} samples of {len(series.flows)} flows to {output}")
+        return
+
+    records = read_flowmon(args.input)
+    if args.csv:
+        names = [field.name for field in fields(FlowRecord)]
+        text = ",".join(names) + "\n"
+        text += "".join(",".join(str(getattr(record, name)) for name in names) + "\n" for record in records)
+    else:
+        text = to_xml(records)
+
+    output = args.output or args.input.with_suffix(".csv" if args.csv else ".flowmon")
+    if str(output) == "-":
+        sys.stdout.write(text)
+    else:
+        output.write_text(text, encoding="utf-8")
+        print(f"Wrote {len(records)} flows to {output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef AIRTIME_BREAKDOWN_H
+#define AIRTIME_BREAKDOWN_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Per-device airtime split by what the radio was doing, for the period after @p from.
+ *
+ * Transmit time comes from PhyTxPsduBegin and is split into data, retransmitted data
+ * (MPDUs with the Retry bit, pro rata inside an A-MPDU), control (ACK, Block Ack, RTS,
+ * CTS, ...) and management frames. Unacknowledged is the part of the data airtime whose
+ * ACK or Block Ack never came (response timeout); on this error-free channel those are
+ * collisions. Receive, CCA-busy and idle time (idle includes backoff) come from the PHY
+ * state trace. Every trace callback only adds to fixed counters. transmitTotal also counts
+ * the transmissions before @p from, like AirtimeLogger.
+ */
+class AirtimeBreakdown
+{
+  public:
+    struct Counters
+    {
+        double data = 0.0;           // s, first transmissions
+        double retry = 0.0;          // s, retransmissions
+        double control = 0.0;        // s
+        double management = 0.0;     // s
+        double unacknowledged = 0.0; // s of data/retry PPDUs without a response
+        double receive = 0.0;        // s
+        double ccaBusy = 0.0;        // s, medium busy with frames not addressed to us
+        double idle = 0.0;           // s, including backoff
+        uint64_t ppdus = 0;
+        double transmitTotal = 0.0;  // s, every transmission since Track(), warm-up included
+
+        double Transmit() const
+        {
+            return data + retry + control + management;
+        }
+    };
+
+    explicit AirtimeBreakdown(Time from)
+        : m_from(from)
+    {
+    }
+
+    /// Starts accounting for @p device; returns the index for Get().
+    uint32_t Track(Ptr<NetDevice> device)
+    {
+        Ptr<WifiNetDevice> wifiDevice = DynamicCast<WifiNetDevice>(device);
+        NS_ABORT_MSG_IF(!wifiDevice, "AirtimeBreakdown only tracks WifiNetDevices");
+        m_devices.push_back(std::make_unique<Device>(wifiDevice->GetPhy(), m_from));
+        Device* tracked = m_devices.back().get();
+        wifiDevice->GetPhy()->TraceConnectWithoutContext("PhyTxPsduBegin",
+                                                         MakeCallback(&Device::TxPsdu, tracked));
+        wifiDevice->GetPhy()->GetState()->TraceConnectWithoutContext("State",
+                                                                     MakeCallback(&Device::State, tracked));
+        wifiDevice->GetMac()->TraceConnectWithoutContext("MpduResponseTimeout",
+                                                         MakeCallback(&Device::MpduTimeout, tracked));
+        wifiDevice->GetMac()->TraceConnectWithoutContext("PsduResponseTimeout",
+                                                         MakeCallback(&Device::PsduTimeout, tracked));
+        return m_devices.size() - 1;
+    }
+
+    const Counters& Get(uint32_t index) const
+    {
+        return m_devices.at(index)->counters;
+    }
+
+  private:
+    struct Device
+    {
+        Device(Ptr<WifiPhy> devicePhy, Time start)
+            : phy(devicePhy),
+              from(start)
+        {
+        }
+
+        void TxPsdu(WifiConstPsduMap psduMap, WifiTxVector txVector, double /* txPowerW */)
+        {
+            const double duration =
+                WifiPhy::CalculateTxDuration(psduMap, txVector, phy->GetPhyBand()).GetSeconds();
+            counters.transmitTotal += duration;
+            if (Simulator::Now() < from)
+            {
+                return;
+            }
+            ++counters.ppdus;
+            // An MU PPDU is charged once, split like its first PSDU.
+            const Ptr<const WifiPsdu> psdu = psduMap.begin()->second;
+            const WifiMacHeader& header = psdu->GetHeader(0);
+            if (header.IsCtl())
+            {
+                counters.control += duration;
+                return;
+            }
+            if (header.IsMgt())
+            {
+                counters.management += duration;
+                return;
+            }
+            const uint32_t mpdus = psdu->GetNMpdus();
+            uint32_t retries = 0;
+            for (uint32_t i = 0; i < mpdus; ++i)
+            {
+                retries += psdu->GetHeader(i).IsRetry() ? 1 : 0;
+            }
+            counters.retry += duration * retries / mpdus;
+            counters.data += duration * (mpdus - retries) / mpdus;
+        }
+
+        void State(Time start, Time duration, WifiPhyState state)
+        {
+            const Time end = start + duration;
+            if (end <= from)
+            {
+                return;
+            }
+            const double seconds = (end - std::max(start, from)).GetSeconds();
+            switch (state)
+            {
+            case WifiPhyState::IDLE:
+                counters.idle += seconds;
+                break;
+            case WifiPhyState::CCA_BUSY:
+                counters.ccaBusy += seconds;
+                break;
+            case WifiPhyState::RX:
+                counters.receive += seconds;
+                break;
+            default:
+                break;
+            }
+        }
+
+        void MpduTimeout(uint8_t /* reason */, Ptr<const WifiMpdu> mpdu, const WifiTxVector& txVector)
+        {
+            AddUnacknowledged(mpdu->GetSize(), txVector);
+        }
+
+        void PsduTimeout(uint8_t /* reason */, Ptr<const WifiPsdu> psdu, const WifiTxVector& txVector)
+        {
+            AddUnacknowledged(psdu->GetSize(), txVector);
+        }
+
+        void AddUnacknowledged(uint32_t size, const WifiTxVector& txVector)
+        {
+            if (Simulator::Now() < from)
+            {
+                return;
+            }
+            counters.unacknowledged +=
+                WifiPhy::CalculateTxDuration(size, txVector, phy->GetPhyBand()).GetSeconds();
+        }
+
+        Ptr<WifiPhy> phy;
+        Time from;
+        Counters counters;
+    };
+
+    Time m_from;
+    std::vector<std::unique_ptr<Device>> m_devices;
+};
+
+} // namespace ns3
+
+#endif /* AIRTIME_BREAKDOWN_H */
@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef ANOMALY_MODEL_H
+#define ANOMALY_MODEL_H
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Closed-form estimate of the coexistence scenarios: every STA sends saturated uplink UDP
+ * over one collision domain, as in scenario_coex.
+ *
+ * Access follows Bianchi's DCF model (saturated stations, CWmin 15, CWmax 1023, no retry
+ * limit, ideal channel), so every STA wins the same share of transmissions whatever its rate
+ * -- the performance anomaly. A success of a STA costs AIFS + PPDU + SIFS + Ack/Block Ack, a
+ * collision costs AIFS + the longest colliding PPDU + the response timeout. PPDU durations
+ * come from the OFDM numerology of each format (single stream, HT/VHT 800 ns GI, HE/EHT
+ * 2x LTF, no packet extension); responses use the BSS control mode. A-MPDUs are limited by
+ * the A-MPDU size, the Block Ack window of the standard and the 5.484 ms PPDU limit.
+ */
+class AnomalyModel
+{
+  public:
+    struct Bss
+    {
+        std::string label;       // e.g. "802.11ax"
+        std::string standard;    // "a", "n", "ac", "ax" or "be"
+        uint32_t staCount;
+        std::string dataMode;    // ns-3 mode name, e.g. "HeMcs11"
+        std::string controlMode; // ns-3 mode name, e.g. "HeMcs0"
+    };
+
+    struct Parameters
+    {
+        std::vector<Bss> bsses;
+        double channelWidth = 20.0;         // MHz
+        bool band2_4GHz = false;            // SIFS 10 us instead of 16 us
+        uint32_t maxAmpduBytes = 65535;     // BE_MaxAmpduSize, 0 disables aggregation
+        uint32_t payloadBytes = 1472;       // UDP payload
+        double heGuardInterval = 3200e-9;   // s, HE/EHT data symbols (ns-3 HeConfiguration default)
+    };
+
+    struct StationPrediction
+    {
+        std::string label;
+        std::string standard;
+        std::string dataMode;
+        uint32_t staCount = 0;
+        uint32_t mpdusPerPpdu = 0;
+        double ppduDuration = 0.0; // s
+        double throughput = 0.0;   // Mbit/s of IP packets per STA, like the FlowMonitor results
+        double airtime = 0.0;      // fraction of time one STA is transmitting data
+    };
+
+    struct Prediction
+    {
+        double tau = 0.0;                  // transmission probability per slot
+        double collisionProbability = 0.0; // conditional, seen by a transmitting STA
+        double meanSlot = 0.0;             // s
+        double idleShare = 0.0;            // fractions of time
+        double successShare = 0.0;
+        double collisionShare = 0.0;
+        std::vector<StationPrediction> bsses; // one per BSS, per-STA values
+
+        double TotalThroughput() const
+        {
+            double total = 0.0;
+            for (const StationPrediction& bss : bsses)
+            {
+                total += bss.throughput * bss.staCount;
+            }
+            return total;
+        }
+    };
+
+    static Prediction Predict(const Parameters& parameters)
+    {
+        const double slot = 9e-6;
+        const double sifs = parameters.band2_4GHz ? 10e-6 : 16e-6;
+
+        struct Station
+        {
+            double success;   // s
+            double collision; // s
+        };
+
+        Prediction prediction;
+        std::vector<Station> stations;
+        for (const Bss& bss : parameters.bsses)
+        {
+            if (bss.staCount == 0)
+            {
+                continue;
+            }
+            const bool qos = bss.standard != "a";
+            const bool aggregation = qos && parameters.maxAmpduBytes > 0;
+            const PhyTiming data = GetPhyTiming(bss.dataMode, parameters);
+            const PhyTiming control = GetPhyTiming(bss.controlMode, parameters);
+            // QoS data header, LLC/SNAP, IPv4, UDP, payload and FCS
+            const uint32_t mpduBytes = (qos ? 26 : 24) + 8 + 20 + 8 + parameters.payloadBytes + 4;
+
+            uint32_t mpdus = 1;
+            uint32_t psduBytes = mpduBytes;
+            uint32_t responseBytes = 14; // Ack
+            if (aggregation)
+            {
+                const uint32_t subframeBytes = (4 + mpduBytes + 3) / 4 * 4;
+                const uint32_t maxBytes = std::min(parameters.maxAmpduBytes, MaxAmpduBytes(bss.standard));
+                const uint32_t window = BlockAckWindow(bss.standard);
+                mpdus = std::max<uint32_t>(1, std::min(maxBytes / subframeBytes, window));
+                while (mpdus > 1 && data.Duration(mpdus * subframeBytes) > 5.484e-3)
+                {
+                    --mpdus;
+                }
+                psduBytes = mpdus * subframeBytes;
+                responseBytes = window <= 64 ? 32 : window <= 256 ? 56 : 152; // compressed Block Ack
+            }
+
+            const double aifs = sifs + (qos ? 3 : 2) * slot;
+            const double ppdu = data.Duration(psduBytes);
+            const double response = control.Duration(responseBytes);
+            const double timeout = sifs + slot + control.preamble;
+
+            StationPrediction result;
+            result.label = bss.label;
+            result.standard = bss.standard;
+            result.dataMode = bss.dataMode;
+            result.staCount = bss.staCount;
+            result.mpdusPerPpdu = mpdus;
+            result.ppduDuration = ppdu;
+            prediction.bsses.push_back(result);
+            for (uint32_t i = 0; i < bss.staCount; ++i)
+            {
+                stations.push_back({aifs + ppdu + sifs + response, aifs + ppdu + timeout});
+            }
+        }
+        NS_ABORT_MSG_IF(stations.empty(), "AnomalyModel needs at least one STA");
+
+        const uint32_t n = stations.size();
+        const double tau = SolveTransmissionProbability(n);
+        const double success = tau * std::pow(1.0 - tau, n - 1); // one given STA alone
+        prediction.tau = tau;
+        prediction.collisionProbability = 1.0 - std::pow(1.0 - tau, n - 1);
+
+        double idle = std::pow(1.0 - tau, n) * slot;
+        double successTime = 0.0;
+        for (const Station& station : stations)
+        {
+            successTime += success * station.success;
+        }
+        // A collision lasts as long as its longest frame: station k is the longest involved
+        // when it transmits, no longer one does and at least one shorter one does.
+        std::sort(stations.begin(), stations.end(), [](const Station& a, const Station& b) {
+            return a.collision > b.collision;
+        });
+        double collisionTime = 0.0;
+        for (uint32_t k = 0; k < n; ++k)
+        {
+            collisionTime +=
+                tau * std::pow(1.0 - tau, k) * (1.0 - std::pow(1.0 - tau, n - k - 1)) * stations[k].collision;
+        }
+        const double meanSlot = idle + successTime + collisionTime;
+        prediction.meanSlot = meanSlot;
+        prediction.idleShare = idle / meanSlot;
+        prediction.successShare = successTime / meanSlot;
+        prediction.collisionShare = collisionTime / meanSlot;
+
+        const uint32_t ipBytes = parameters.payloadBytes + 28;
+        for (StationPrediction& bss : prediction.bsses)
+        {
+            bss.throughput = success * bss.mpdusPerPpdu * ipBytes * 8.0 / meanSlot / 1e6;
+            bss.airtime = tau * bss.ppduDuration / meanSlot;
+        }
+        return prediction;
+    }
+
+  private:
+    struct PhyTiming
+    {
+        double preamble;      // s
+        double symbol;        // s
+        double bitsPerSymbol; // data bits per OFDM symbol
+
+        /// PPDU duration for a PSDU of @p bytes, with the 16 service and 6 tail bits.
+        double Duration(uint32_t bytes) const
+        {
+            return preamble + std::ceil((16.0 + 8.0 * bytes + 6.0) / bitsPerSymbol) * symbol;
+        }
+    };
+
+    static PhyTiming GetPhyTiming(const std::string& mode, const Parameters& parameters)
+    {
+        // Coded bits per subcarrier times the code rate, by MCS.
+        static const double rates[] = {0.5, 1.0, 1.5, 2.0, 3.0, 4.0, 4.5, 5.0, 6.0, 20.0 / 3, 7.5, 25.0 / 3, 9.0, 10.0};
+        const double width = parameters.channelWidth;
+        const double heSymbol = 12.8e-6 + parameters.heGuardInterval;
+        const double heLtf = 6.4e-6 + parameters.heGuardInterval;
+        uint32_t index = 0;
+        if (ParseIndex(mode, "OfdmRate", "Mbps", index))
+        {
+            return {20e-6, 4e-6, index * 4.0};
+        }
+        if (ParseIndex(mode, "HtMcs", "", index) && index < 32)
+        {
+            const uint32_t nss = index / 8 + 1;
+            const uint32_t ltfs = nss == 3 ? 4 : nss;
+            const double subcarriers = width >= 40 ? 108 : 52;
+            return {(32 + 4 * ltfs) * 1e-6, 4e-6, std::floor(subcarriers * rates[index % 8] * nss)};
+        }
+        if (ParseIndex(mode, "VhtMcs", "", index) && index < 10)
+        {
+            const double subcarriers = width >= 160 ? 468 : width >= 80 ? 234 : width >= 40 ? 108 : 52;
+            return {40e-6, 4e-6, std::floor(subcarriers * rates[index])};
+        }
+        const double heSubcarriers =
+            width >= 320 ? 3920 : width >= 160 ? 1960 : width >= 80 ? 980 : width >= 40 ? 468 : 234;
+        if (ParseIndex(mode, "HeMcs", "", index) && index < 12)
+        {
+            return {36e-6 + heLtf, heSymbol, std::floor(heSubcarriers * rates[index])};
+        }
+        if (ParseIndex(mode, "EhtMcs", "", index) && index < 14)
+        {
+            return {40e-6 + heLtf, heSymbol, std::floor(heSubcarriers * rates[index])};
+        }
+        NS_ABORT_MSG("AnomalyModel does not know the Wi-Fi mode " << mode);
+        return {};
+    }
+
+    static bool ParseIndex(const std::string& mode, const std::string& prefix, const std::string& suffix, uint32_t& index)
+    {
+        if (mode.size() <= prefix.size() + suffix.size() || mode.compare(0, prefix.size(), prefix) != 0 ||
+            mode.compare(mode.size() - suffix.size(), suffix.size(), suffix) != 0)
+        {
+            return false;
+        }
+        const std::string digits = mode.substr(prefix.size(), mode.size() - prefix.size() - suffix.size());
+        if (digits.find_first_not_of("0123456789") != std::string::npos)
+        {
+            return false;
+        }
+        index = std::stoul(digits);
+        return true;
+    }
+
+    static uint32_t MaxAmpduBytes(const std::string& standard)
+    {
+        return standard == "n" ? 65535 : standard == "ac" ? 1048575 : standard == "ax" ? 6500631 : 15523200;
+    }
+
+    static uint32_t BlockAckWindow(const std::string& standard)
+    {
+        return standard == "n" || standard == "ac" ? 64 : standard == "ax" ? 256 : 1024;
+    }
+
+    /// Bianchi's fixed point tau = 2 / (1 + W + p W sum_{k<m} (2p)^k), p = 1 - (1 - tau)^(n-1).
+    static double SolveTransmissionProbability(uint32_t stations)
+    {
+        const double w = 16.0; // CWmin + 1
+        const uint32_t stages = 6; // CWmax + 1 = 2^6 (CWmin + 1)
+        auto transmission = [&](double p) {
+            double sum = 0.0;
+            for (uint32_t k = 0; k < stages; ++k)
+            {
+                sum += std::pow(2.0 * p, k);
+            }
+            return 2.0 / (1.0 + w + p * w * sum);
+        };
+        double low = 0.0;
+        double high = 1.0;
+        for (int i = 0; i < 100; ++i)
+        {
+            const double tau = (low + high) / 2;
+            const double p = 1.0 - std::pow(1.0 - tau, stations - 1);
+            (tau < transmission(p) ? low : high) = tau;
+        }
+        return (low + high) / 2;
+    }
+};
+
+} // namespace ns3
+
+#endif /* ANOMALY_MODEL_H */
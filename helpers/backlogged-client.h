@@ -0,0 +1,204 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef BACKLOGGED_CLIENT_H
+#define BACKLOGGED_CLIENT_H
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+namespace ns3
+{
+
+/**
+ * Saturated UDP (or packet socket) source that sends only what the Wi-Fi MAC can take.
+ *
+ * Instead of a send timer, the client watches the BE queue of the node's WifiNetDevice and
+ * tops it up to its capacity whenever it holds fewer MPDUs than Threshold: the MPDUs acked
+ * (or dropped) at one instant trigger a single refill event. The MAC therefore always has a
+ * full queue to aggregate from, as with a UdpClient sending faster than the channel, but no
+ * packets are created only to be dropped. When the device does not accept packets (before
+ * association) the client retries every RetryInterval.
+ *
+ * Packets carry a SeqTsHeader like UdpClient's, so UdpServer and FlowMonitor work unchanged.
+ * With Protocol set to PacketSocketFactory and a PacketSocketAddress as Remote, the packets go
+ * straight to the WifiNetDevice without an IP stack.
+ */
+class BackloggedClient : public Application
+{
+  public:
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("ns3::BackloggedClient")
+                .SetParent<Application>()
+                .SetGroupName("Applications")
+                .AddConstructor<BackloggedClient>()
+                .AddAttribute("Remote",
+                              "Destination address and port",
+                              AddressValue(),
+                              MakeAddressAccessor(&BackloggedClient::m_peer),
+                              MakeAddressChecker())
+                .AddAttribute("Protocol",
+                              "Socket factory of the sending socket (UdpSocketFactory or PacketSocketFactory)",
+                              TypeIdValue(UdpSocketFactory::GetTypeId()),
+                              MakeTypeIdAccessor(&BackloggedClient::m_protocol),
+                              MakeTypeIdChecker())
+                .AddAttribute("PacketSize",
+                              "Size of the UDP payload (or of the whole packet), SeqTsHeader included",
+                              UintegerValue(1472),
+                              MakeUintegerAccessor(&BackloggedClient::m_size),
+                              MakeUintegerChecker<uint32_t>(12, 65507))
+                .AddAttribute("Threshold",
+                              "Refill the BE queue once it holds fewer MPDUs than this (0: its capacity)",
+                              UintegerValue(0),
+                              MakeUintegerAccessor(&BackloggedClient::m_threshold),
+                              MakeUintegerChecker<uint32_t>())
+                .AddAttribute("RetryInterval",
+                              "Time before trying again when the device did not accept packets",
+                              TimeValue(MilliSeconds(1)),
+                              MakeTimeAccessor(&BackloggedClient::m_retryInterval),
+                              MakeTimeChecker())
+                .AddTraceSource("Tx",
+                                "A packet has been sent",
+                                MakeTraceSourceAccessor(&BackloggedClient::m_txTrace),
+                                "ns3::Packet::AddressTracedCallback");
+        return tid;
+    }
+
+    uint64_t GetSent() const
+    {
+        return m_sent;
+    }
+
+  private:
+    void StartApplication() override
+    {
+        for (uint32_t i = 0; i < GetNode()->GetNDevices() && !m_queue; ++i)
+        {
+            if (Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(GetNode()->GetDevice(i)))
+            {
+                // A non-QoS MAC (802.11a) has no EDCA queues, only the DCF one.
+                Ptr<WifiMac> mac = device->GetMac();
+                m_queue = mac->GetTxopQueue(mac->GetQosSupported() ? AC_BE : AC_BE_NQOS);
+            }
+        }
+        NS_ABORT_MSG_IF(!m_queue, "BackloggedClient needs a WifiNetDevice on its node");
+        m_capacity = m_queue->GetMaxSize().GetValue();
+        if (m_threshold == 0 || m_threshold > m_capacity)
+        {
+            m_threshold = m_capacity;
+        }
+
+        m_socket = Socket::CreateSocket(GetNode(), m_protocol);
+        NS_ABORT_MSG_IF(m_socket->Bind() == -1 || m_socket->Connect(m_peer) == -1,
+                        "BackloggedClient cannot connect to its remote");
+
+        m_queue->TraceConnectWithoutContext("Dequeue", MakeCallback(&BackloggedClient::Shrunk, this));
+        m_queue->TraceConnectWithoutContext("Drop", MakeCallback(&BackloggedClient::Shrunk, this));
+        m_queue->TraceConnectWithoutContext("Expired", MakeCallback(&BackloggedClient::Shrunk, this));
+        m_running = true;
+        Refill();
+    }
+
+    void StopApplication() override
+    {
+        m_running = false;
+        m_refill.Cancel();
+        if (m_queue)
+        {
+            m_queue->TraceDisconnectWithoutContext("Dequeue", MakeCallback(&BackloggedClient::Shrunk, this));
+            m_queue->TraceDisconnectWithoutContext("Drop", MakeCallback(&BackloggedClient::Shrunk, this));
+            m_queue->TraceDisconnectWithoutContext("Expired", MakeCallback(&BackloggedClient::Shrunk, this));
+        }
+        if (m_socket)
+        {
+            m_socket->Close();
+        }
+    }
+
+    void Shrunk(Ptr<const WifiMpdu> /* mpdu */)
+    {
+        // Sending from inside the queue's trace would modify the queue while it is updated.
+        if (m_running && !m_refill.IsPending() && m_queue->GetNPackets() < m_threshold)
+        {
+            m_refill = Simulator::ScheduleNow(&BackloggedClient::Refill, this);
+        }
+    }
+
+    void Refill()
+    {
+        uint32_t queued = m_queue->GetNPackets();
+        for (uint32_t i = 0; i < m_capacity && queued < m_capacity; ++i)
+        {
+            SeqTsHeader seqTs;
+            seqTs.SetSeq(m_sent++);
+            Ptr<Packet> packet = Create<Packet>(m_size - seqTs.GetSerializedSize());
+            packet->AddHeader(seqTs);
+            m_socket->Send(packet);
+            const uint32_t now = m_queue->GetNPackets();
+            if (now == queued)
+            {
+                break; // not accepted by the MAC
+            }
+            m_txTrace(packet, m_peer);
+            queued = now;
+        }
+        if (queued < m_threshold)
+        {
+            m_refill = Simulator::Schedule(m_retryInterval, &BackloggedClient::Refill, this);
+        }
+    }
+
+    Address m_peer;
+    TypeId m_protocol;
+    uint32_t m_size = 1472;
+    uint32_t m_threshold = 0;
+    Time m_retryInterval;
+    Ptr<Socket> m_socket;
+    Ptr<WifiMacQueue> m_queue;
+    uint32_t m_capacity = 0;
+    uint64_t m_sent = 0;
+    bool m_running = false;
+    EventId m_refill;
+    TracedCallback<Ptr<const Packet>, const Address&> m_txTrace;
+};
+
+/// Installs BackloggedClients sending to @p address : @p port, like UdpClientHelper, or over a
+/// packet socket to @p remote.
+class BackloggedClientHelper
+{
+  public:
+    BackloggedClientHelper(Ipv4Address address, uint16_t port)
+    {
+        m_factory.SetTypeId(BackloggedClient::GetTypeId());
+        m_factory.Set("Remote", AddressValue(InetSocketAddress(address, port)));
+    }
+
+    explicit BackloggedClientHelper(const PacketSocketAddress& remote)
+    {
+        m_factory.SetTypeId(BackloggedClient::GetTypeId());
+        m_factory.Set("Remote", AddressValue(remote));
+        m_factory.Set("Protocol", TypeIdValue(PacketSocketFactory::GetTypeId()));
+    }
+
+    void SetAttribute(const std::string& name, const AttributeValue& value)
+    {
+        m_factory.Set(name, value);
+    }
+
+    ApplicationContainer Install(Ptr<Node> node) const
+    {
+        Ptr<Application> app = m_factory.Create<BackloggedClient>();
+        node->AddApplication(app);
+        return ApplicationContainer(app);
+    }
+
+  private:
+    ObjectFactory m_factory;
+};
+
+} // namespace ns3
+
+#endif /* BACKLOGGED_CLIENT_H */
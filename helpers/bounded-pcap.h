@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef BOUNDED_PCAP_H
+#define BOUNDED_PCAP_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/// Limits of a BoundedPcapHelper capture. Zero means "no limit" for every field.
+struct BoundedPcapOptions
+{
+    uint32_t snapLen = 0;      // bytes kept per frame, radiotap header included
+    bool headerOnly = false;   // keep only the radiotap and 802.11 MAC headers
+    Time start;                // first captured instant
+    Time stop;                 // end of the capture window (zero: until the end of the run)
+    uint64_t maxFileBytes = 0; // rotate to a new file once this size is reached
+    uint32_t maxFiles = 0;     // keep only the newest files of every device
+};
+
+/**
+ * Radiotap pcap capture of Wi-Fi devices with bounded output.
+ *
+ * Unlike WifiPhyHelper::EnablePcap the capture can be cut to a snap length or to the MAC
+ * headers, restricted to a time window and rotated by file size. Files are named like the
+ * helper's (prefix-node-device.pcap); rotated parts get .1, .2, ... before the extension.
+ *
+ * The radiotap header is a fixed 24-byte one (TSFT, flags, legacy rate, channel, signal
+ * and noise). The rate is only present for DSSS/OFDM frames: HT/VHT/HE/EHT MCS fields are
+ * not written, use WifiPhyHelper::EnablePcap when they are needed.
+ */
+class BoundedPcapHelper
+{
+  public:
+    explicit BoundedPcapHelper(const BoundedPcapOptions& options)
+        : m_options(options)
+    {
+    }
+
+    void Enable(const std::string& prefix, const NetDeviceContainer& devices)
+    {
+        for (uint32_t i = 0; i < devices.GetN(); ++i)
+        {
+            Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+            NS_ABORT_MSG_IF(!device, "BoundedPcapHelper only captures WifiNetDevices");
+            std::ostringstream base;
+            base << prefix << "-" << device->GetNode()->GetId() << "-" << device->GetIfIndex();
+            m_captures.push_back(std::make_unique<DeviceCapture>(base.str(), m_options));
+            DeviceCapture* capture = m_captures.back().get();
+            device->GetPhy()->TraceConnectWithoutContext(
+                "MonitorSnifferTx",
+                MakeCallback(&DeviceCapture::SniffTx, capture));
+            device->GetPhy()->TraceConnectWithoutContext(
+                "MonitorSnifferRx",
+                MakeCallback(&DeviceCapture::SniffRx, capture));
+        }
+    }
+
+  private:
+    static constexpr uint32_t LINKTYPE_IEEE802_11_RADIOTAP = 127;
+    static constexpr uint32_t RADIOTAP_LENGTH = 24;
+
+    class DeviceCapture
+    {
+      public:
+        DeviceCapture(const std::string& base, const BoundedPcapOptions& options)
+            : m_base(base),
+              m_options(options)
+        {
+        }
+
+        void SniffTx(Ptr<const Packet> packet,
+                     MHz_u channelFreq,
+                     WifiTxVector txVector,
+                     MpduInfo /* aMpdu */,
+                     uint16_t /* staId */)
+        {
+            Write(packet, channelFreq, txVector, 0, 0, false);
+        }
+
+        void SniffRx(Ptr<const Packet> packet,
+                     MHz_u channelFreq,
+                     WifiTxVector txVector,
+                     MpduInfo /* aMpdu */,
+                     SignalNoiseDbm signalNoise,
+                     uint16_t /* staId */)
+        {
+            Write(packet, channelFreq, txVector, signalNoise.signal, signalNoise.noise, true);
+        }
+
+      private:
+        void Write(Ptr<const Packet> packet,
+                   MHz_u channelFreq,
+                   const WifiTxVector& txVector,
+                   double signalDbm,
+                   double noiseDbm,
+                   bool withSignal)
+        {
+            const Time now = Simulator::Now();
+            if (now < m_options.start || (m_options.stop.IsStrictlyPositive() && now >= m_options.stop))
+            {
+                return;
+            }
+
+            uint32_t frameBytes = packet->GetSize();
+            if (m_options.headerOnly)
+            {
+                WifiMacHeader header;
+                frameBytes = std::min(frameBytes, packet->PeekHeader(header));
+            }
+            if (m_options.snapLen > 0)
+            {
+                frameBytes = std::min(frameBytes, m_options.snapLen > RADIOTAP_LENGTH
+                                                      ? m_options.snapLen - RADIOTAP_LENGTH
+                                                      : 0u);
+            }
+            const uint32_t recordBytes = RADIOTAP_LENGTH + frameBytes;
+            if (!m_file.is_open() ||
+                (m_options.maxFileBytes > 0 && m_fileBytes + 16 + recordBytes > m_options.maxFileBytes &&
+                 m_fileBytes > 24))
+            {
+                Rotate();
+            }
+
+            uint8_t radiotap[RADIOTAP_LENGTH] = {};
+            // The 500 kbit/s rate byte cannot describe MCS modes (an HE MCS 11 would read as
+            // 127.5 Mbit/s), so those frames leave it out; the byte then pads the channel field.
+            const WifiModulationClass modulation = txVector.GetMode().GetModulationClass();
+            const bool legacyRate = modulation == WIFI_MOD_CLASS_DSSS || modulation == WIFI_MOD_CLASS_HR_DSSS ||
+                                    modulation == WIFI_MOD_CLASS_ERP_OFDM || modulation == WIFI_MOD_CLASS_OFDM;
+            // Present: TSFT, flags, rate (legacy modes), channel, dBm signal, dBm noise.
+            const uint32_t present = (1u << 0) | (1u << 1) | (legacyRate ? (1u << 2) : 0u) | (1u << 3) |
+                                     (withSignal ? (1u << 5) | (1u << 6) : 0u);
+            const uint64_t tsft = now.GetMicroSeconds();
+            const uint16_t frequency = static_cast<uint16_t>(channelFreq);
+            const uint16_t channelFlags = 0x0040 | (frequency >= 4900 ? 0x0100 : 0x0080); // OFDM, 5/2 GHz
+            PutLe(radiotap + 2, static_cast<uint16_t>(RADIOTAP_LENGTH));
+            PutLe(radiotap + 4, present);
+            PutLe(radiotap + 8, tsft);
+            radiotap[16] = 0x10; // frame includes FCS
+            if (legacyRate)
+            {
+                radiotap[17] = static_cast<uint8_t>(txVector.GetMode().GetDataRate(txVector) / 500000);
+            }
+            PutLe(radiotap + 18, frequency);
+            PutLe(radiotap + 20, channelFlags);
+            radiotap[22] = static_cast<uint8_t>(static_cast<int8_t>(std::clamp(signalDbm, -128.0, 127.0)));
+            radiotap[23] = static_cast<uint8_t>(static_cast<int8_t>(std::clamp(noiseDbm, -128.0, 127.0)));
+
+            m_buffer.resize(frameBytes);
+            packet->CopyData(m_buffer.data(), frameBytes);
+
+            uint8_t record[16];
+            PutLe(record, static_cast<uint32_t>(tsft / 1000000));
+            PutLe(record + 4, static_cast<uint32_t>(tsft % 1000000));
+            PutLe(record + 8, recordBytes);
+            PutLe(record + 12, RADIOTAP_LENGTH + packet->GetSize());
+            m_file.write(reinterpret_cast<const char*>(record), sizeof(record));
+            m_file.write(reinterpret_cast<const char*>(radiotap), sizeof(radiotap));
+            m_file.write(reinterpret_cast<const char*>(m_buffer.data()), frameBytes);
+            m_fileBytes += sizeof(record) + recordBytes;
+        }
+
+        void Rotate()
+        {
+            if (m_file.is_open())
+            {
+                m_file.close();
+                ++m_part;
+            }
+            if (m_options.maxFiles > 0 && m_part >= m_options.maxFiles)
+            {
+                std::remove(PartPath(m_part - m_options.maxFiles).c_str());
+            }
+            const std::string path = PartPath(m_part);
+            m_file.open(path, std::ios::binary | std::ios::trunc);
+            NS_ABORT_MSG_IF(!m_file, "Cannot open " << path);
+
+            uint8_t header[24];
+            PutLe(header, static_cast<uint32_t>(0xa1b2c3d4));
+            PutLe(header + 4, static_cast<uint16_t>(2));
+            PutLe(header + 6, static_cast<uint16_t>(4));
+            PutLe(header + 8, static_cast<uint32_t>(0));
+            PutLe(header + 12, static_cast<uint32_t>(0));
+            PutLe(header + 16, m_options.snapLen > 0 ? m_options.snapLen : 65535u);
+            PutLe(header + 20, LINKTYPE_IEEE802_11_RADIOTAP);
+            m_file.write(reinterpret_cast<const char*>(header), sizeof(header));
+            m_fileBytes = sizeof(header);
+        }
+
+        std::string PartPath(uint32_t part) const
+        {
+            return part == 0 ? m_base + ".pcap" : m_base + "." + std::to_string(part) + ".pcap";
+        }
+
+        template <typename T>
+        static void PutLe(uint8_t* out, T value)
+        {
+            for (size_t i = 0; i < sizeof(T); ++i)
+            {
+                out[i] = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i));
+            }
+        }
+
+        std::string m_base;
+        BoundedPcapOptions m_options;
+        std::ofstream m_file;
+        uint64_t m_fileBytes = 0;
+        uint32_t m_part = 0;
+        std::vector<uint8_t> m_buffer;
+    };
+
+    BoundedPcapOptions m_options;
+    std::vector<std::unique_ptr<DeviceCapture>> m_captures;
+};
+
+} // namespace ns3
+
+#endif /* BOUNDED_PCAP_H */
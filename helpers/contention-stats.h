@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef CONTENTION_STATS_H
+#define CONTENTION_STATS_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Counter histogram with fixed power-of-two buckets: 0, 1, 2-3, 4-7, ..., and an open last
+ * bucket. Adding a value is a couple of bit operations.
+ */
+class Log2Histogram
+{
+  public:
+    static constexpr uint32_t BUCKETS = 12; // ..., 512-1023, 1024+
+
+    void Add(uint64_t value)
+    {
+        uint32_t bucket = 0;
+        while (value > 0 && bucket < BUCKETS - 1)
+        {
+            value >>= 1;
+            ++bucket;
+        }
+        ++m_counts[bucket];
+    }
+
+    uint64_t GetCount(uint32_t bucket) const
+    {
+        return m_counts[bucket];
+    }
+
+    static std::string GetLabel(uint32_t bucket)
+    {
+        if (bucket <= 1)
+        {
+            return std::to_string(bucket);
+        }
+        const uint64_t low = uint64_t{1} << (bucket - 1);
+        if (bucket == BUCKETS - 1)
+        {
+            return std::to_string(low) + "+";
+        }
+        return std::to_string(low) + "-" + std::to_string(2 * low - 1);
+    }
+
+  private:
+    std::array<uint64_t, BUCKETS> m_counts{};
+};
+
+/**
+ * Per-STA MAC contention histograms collected from trace sinks, for the period after
+ * @p from:
+ *  - A-MPDU length: MPDUs per transmitted data PSDU (PhyTxPsduBegin);
+ *  - MPDU retries: retransmissions an MPDU needed before it was acknowledged (AckedMpdu);
+ *  - backoff slots: every backoff the BE queue drew (BackoffTrace);
+ *  - acknowledgement outcome of every data PSDU: all, some or none of its MPDUs acked, or
+ *    no Ack/Block Ack at all (response timeout).
+ * On a non-QoS MAC (802.11a) the data frames are plain Data and the backoffs are those of
+ * its single DCF Txop.
+ */
+class ContentionStats
+{
+  public:
+    enum AckOutcome
+    {
+        ALL_ACKED = 0,
+        PARTIALLY_ACKED,
+        NONE_ACKED,
+        RESPONSE_TIMEOUT,
+        ACK_OUTCOMES
+    };
+
+    struct Histograms
+    {
+        Log2Histogram ampduLength;
+        Log2Histogram mpduRetries;
+        Log2Histogram backoffSlots;
+        std::array<uint64_t, ACK_OUTCOMES> ackOutcomes{};
+    };
+
+    static std::string GetAckOutcomeName(uint32_t outcome)
+    {
+        static const char* names[] = {"all_acked", "partially_acked", "none_acked", "timeout"};
+        return names[outcome];
+    }
+
+    explicit ContentionStats(Time from)
+        : m_from(from)
+    {
+    }
+
+    /// Starts collecting for @p device; returns the index for Get().
+    uint32_t Track(Ptr<NetDevice> device)
+    {
+        Ptr<WifiNetDevice> wifiDevice = DynamicCast<WifiNetDevice>(device);
+        NS_ABORT_MSG_IF(!wifiDevice, "ContentionStats only tracks WifiNetDevices");
+        Ptr<WifiMac> mac = wifiDevice->GetMac();
+        m_stations.push_back(std::make_unique<Station>(m_from, mac->GetQosSupported()));
+        Station* station = m_stations.back().get();
+        wifiDevice->GetPhy()->TraceConnectWithoutContext("PhyTxPsduBegin",
+                                                         MakeCallback(&Station::TxPsdu, station));
+        mac->TraceConnectWithoutContext("AckedMpdu", MakeCallback(&Station::Acked, station));
+        mac->TraceConnectWithoutContext("NAckedMpdu", MakeCallback(&Station::NAcked, station));
+        mac->TraceConnectWithoutContext("PsduResponseTimeout", MakeCallback(&Station::PsduTimeout, station));
+        mac->TraceConnectWithoutContext("MpduResponseTimeout", MakeCallback(&Station::MpduTimeout, station));
+        Ptr<Txop> txop = station->qos ? Ptr<Txop>(mac->GetQosTxop(AC_BE)) : mac->GetTxop();
+        txop->TraceConnectWithoutContext("BackoffTrace", MakeCallback(&Station::Backoff, station));
+        return m_stations.size() - 1;
+    }
+
+    /// Histograms of station @p index; closes the acknowledgement still being collected.
+    const Histograms& Get(uint32_t index)
+    {
+        Station& station = *m_stations.at(index);
+        station.FlushAck();
+        return station.histograms;
+    }
+
+  private:
+    struct Station
+    {
+        Station(Time start, bool qosSupported)
+            : from(start),
+              qos(qosSupported)
+        {
+        }
+
+        bool Measuring() const
+        {
+            return Simulator::Now() >= from;
+        }
+
+        bool IsData(const WifiMacHeader& header) const
+        {
+            return qos ? header.IsQosData() : header.IsData();
+        }
+
+        void TxPsdu(WifiConstPsduMap psduMap, WifiTxVector /* txVector */, double /* txPowerW */)
+        {
+            const Ptr<const WifiPsdu> psdu = psduMap.begin()->second;
+            if (Measuring() && IsData(psdu->GetHeader(0)))
+            {
+                histograms.ampduLength.Add(psdu->GetNMpdus());
+            }
+        }
+
+        // The Acked/NAcked callbacks of one Ack or Block Ack all fire at the same instant.
+        void Acked(Ptr<const WifiMpdu> mpdu)
+        {
+            if (!Measuring() || !IsData(mpdu->GetHeader()))
+            {
+                return;
+            }
+            histograms.mpduRetries.Add(mpdu->GetRetryCount());
+            CountAck(true);
+        }
+
+        void NAcked(Ptr<const WifiMpdu> mpdu)
+        {
+            if (Measuring() && IsData(mpdu->GetHeader()))
+            {
+                CountAck(false);
+            }
+        }
+
+        void CountAck(bool acked)
+        {
+            if (Simulator::Now() != pendingTime)
+            {
+                FlushAck();
+                pendingTime = Simulator::Now();
+            }
+            ++(acked ? pendingAcked : pendingNAcked);
+        }
+
+        void FlushAck()
+        {
+            if (pendingAcked + pendingNAcked > 0)
+            {
+                const AckOutcome outcome = pendingNAcked == 0  ? ALL_ACKED
+                                           : pendingAcked == 0 ? NONE_ACKED
+                                                               : PARTIALLY_ACKED;
+                ++histograms.ackOutcomes[outcome];
+            }
+            pendingAcked = 0;
+            pendingNAcked = 0;
+        }
+
+        void PsduTimeout(uint8_t /* reason */, Ptr<const WifiPsdu> psdu, const WifiTxVector& /* txVector */)
+        {
+            if (Measuring() && IsData(psdu->GetHeader(0)))
+            {
+                ++histograms.ackOutcomes[RESPONSE_TIMEOUT];
+            }
+        }
+
+        void MpduTimeout(uint8_t /* reason */, Ptr<const WifiMpdu> mpdu, const WifiTxVector& /* txVector */)
+        {
+            if (Measuring() && IsData(mpdu->GetHeader()))
+            {
+                ++histograms.ackOutcomes[RESPONSE_TIMEOUT];
+            }
+        }
+
+        void Backoff(uint32_t slots, uint8_t /* linkId */)
+        {
+            if (Measuring())
+            {
+                histograms.backoffSlots.Add(slots);
+            }
+        }
+
+        Time from;
+        bool qos;
+        Histograms histograms;
+        Time pendingTime = Seconds(-1.0);
+        uint32_t pendingAcked = 0;
+        uint32_t pendingNAcked = 0;
+    };
+
+    Time m_from;
+    std::vector<std::unique_ptr<Station>> m_stations;
+};
+
+} // namespace ns3
+
+#endif /* CONTENTION_STATS_H */
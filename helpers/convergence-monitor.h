@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef CONVERGENCE_MONITOR_H
+#define CONVERGENCE_MONITOR_H
+
+#include "ns3/core-module.h"
+#include "ns3/flow-monitor-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Batch-means convergence check for FlowMonitor statistics.
+ *
+ * Every batch interval the monitor takes the per-flow throughput and mean delay of the
+ * batch that just ended. Once every flow has at least minBatches batches and the 95 %
+ * confidence interval half-width of both metrics is below targetPrecision times their
+ * mean, the simulation is stopped. The caller keeps its own Simulator::Stop as the hard
+ * upper bound.
+ */
+class ConvergenceMonitor
+{
+  public:
+    ConvergenceMonitor(Ptr<FlowMonitor> monitor,
+                       Time batchInterval,
+                       double targetPrecision,
+                       uint32_t minBatches)
+        : m_monitor(monitor),
+          m_batchInterval(batchInterval),
+          m_targetPrecision(targetPrecision),
+          m_minBatches(minBatches)
+    {
+    }
+
+    /// Takes the baseline sample at @p start (normally when the clients start).
+    void Start(Time start)
+    {
+        Simulator::Schedule(start, &ConvergenceMonitor::Sample, this);
+    }
+
+    bool HasConverged() const
+    {
+        return m_converged;
+    }
+
+    /// Simulation time at which the monitor stopped the run.
+    Time GetConvergenceTime() const
+    {
+        return m_convergenceTime;
+    }
+
+    uint32_t GetBatchCount() const
+    {
+        return m_batches;
+    }
+
+    /// Largest relative CI half-width over all flows and both metrics at the last check.
+    double GetWorstPrecision() const
+    {
+        return m_worstPrecision;
+    }
+
+    /// Two-sided 95 % Student t quantile.
+    static double StudentT95(uint32_t degreesOfFreedom)
+    {
+        static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                       2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                       2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                       2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+        if (degreesOfFreedom == 0)
+        {
+            return INFINITY;
+        }
+        if (degreesOfFreedom <= 30)
+        {
+            return table[degreesOfFreedom - 1];
+        }
+        // Cornish-Fisher expansion around the normal quantile, good to 1e-3 above 30 df.
+        const double z = 1.959964;
+        const double df = degreesOfFreedom;
+        return z + (z * z * z + z) / (4.0 * df) +
+               (5.0 * std::pow(z, 5) + 16.0 * z * z * z + 3.0 * z) / (96.0 * df * df);
+    }
+
+    /// Relative 95 % CI half-width of the batch means; 0 when all batches are equal.
+    static double RelativePrecision(const std::vector<double>& samples)
+    {
+        const double n = samples.size();
+        if (samples.size() < 2)
+        {
+            return INFINITY;
+        }
+        double mean = 0.0;
+        for (double sample : samples)
+        {
+            mean += sample;
+        }
+        mean /= n;
+        double variance = 0.0;
+        for (double sample : samples)
+        {
+            variance += (sample - mean) * (sample - mean);
+        }
+        variance /= (n - 1.0);
+        const double halfWidth = StudentT95(samples.size() - 1) * std::sqrt(variance / n);
+        if (halfWidth == 0.0)
+        {
+            return 0.0;
+        }
+        return halfWidth / std::fabs(mean);
+    }
+
+  private:
+    struct FlowBatches
+    {
+        uint64_t rxBytes = 0;
+        uint32_t rxPackets = 0;
+        Time delaySum;
+        std::vector<double> throughput; // bit/s
+        std::vector<double> delay;      // s
+    };
+
+    void Sample()
+    {
+        const bool baseline = !m_started;
+        m_started = true;
+        const double batchSeconds = m_batchInterval.GetSeconds();
+
+        for (const auto& [flowId, stats] : m_monitor->GetFlowStats())
+        {
+            FlowBatches& flow = m_flows[flowId];
+            if (!baseline)
+            {
+                const uint64_t bytes = stats.rxBytes - flow.rxBytes;
+                const uint32_t packets = stats.rxPackets - flow.rxPackets;
+                flow.throughput.push_back(bytes * 8.0 / batchSeconds);
+                if (packets > 0)
+                {
+                    flow.delay.push_back((stats.delaySum - flow.delaySum).GetSeconds() / packets);
+                }
+            }
+            flow.rxBytes = stats.rxBytes;
+            flow.rxPackets = stats.rxPackets;
+            flow.delaySum = stats.delaySum;
+        }
+        if (!baseline)
+        {
+            ++m_batches;
+        }
+
+        if (m_batches >= m_minBatches && !m_flows.empty() && Check())
+        {
+            m_converged = true;
+            m_convergenceTime = Simulator::Now();
+            Simulator::Stop();
+            return;
+        }
+        Simulator::Schedule(m_batchInterval, &ConvergenceMonitor::Sample, this);
+    }
+
+    bool Check()
+    {
+        m_worstPrecision = 0.0;
+        for (const auto& [flowId, flow] : m_flows)
+        {
+            if (flow.throughput.size() < m_minBatches)
+            {
+                m_worstPrecision = INFINITY;
+                return false;
+            }
+            m_worstPrecision = std::max(m_worstPrecision, RelativePrecision(flow.throughput));
+            // A starved flow has no delay samples; its throughput CI alone decides.
+            if (flow.delay.size() >= 2)
+            {
+                m_worstPrecision = std::max(m_worstPrecision, RelativePrecision(flow.delay));
+            }
+        }
+        return m_worstPrecision <= m_targetPrecision;
+    }
+
+    Ptr<FlowMonitor> m_monitor;
+    Time m_batchInterval;
+    double m_targetPrecision;
+    uint32_t m_minBatches;
+    std::map<FlowId, FlowBatches> m_flows;
+    uint32_t m_batches = 0;
+    bool m_started = false;
+    bool m_converged = false;
+    Time m_convergenceTime;
+    double m_worstPrecision = INFINITY;
+};
+
+} // namespace ns3
+
+#endif /* CONVERGENCE_MONITOR_H */
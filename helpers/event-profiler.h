@@ -0,0 +1,295 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Scheduler that attributes every executed event, and the wall time until the simulator
+ * asks for the next one, to the source of the event. Events are kept by the scheduler given
+ * in the Scheduler attribute (map by default); install it with Simulator::SetScheduler.
+ *
+ * The source is the dynamic type of the EventImpl: MakeEvent instantiates one class per
+ * handler signature, so its demangled name names the class of a member-function handler
+ * (UdpClient, Txop, YansWifiPhy, ...), or the function enclosing a lambda. Sources are grouped
+ * into application, internet, mac, phy, channel, mobility, netanim, monitoring and other.
+ * The measured time includes the bookkeeping of the simulator after the handler (releasing
+ * the event), and cancelled events are counted but do not run.
+ */
+class EventSourceProfiler : public Scheduler
+{
+  public:
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("ns3::EventSourceProfiler")
+                .SetParent<Scheduler>()
+                .SetGroupName("Core")
+                .AddConstructor<EventSourceProfiler>()
+                .AddAttribute("Scheduler",
+                              "Scheduler that keeps the events",
+                              TypeIdValue(MapScheduler::GetTypeId()),
+                              MakeTypeIdAccessor(&EventSourceProfiler::SetScheduler),
+                              MakeTypeIdChecker());
+        return tid;
+    }
+
+    EventSourceProfiler()
+    {
+        s_active = this;
+    }
+
+    ~EventSourceProfiler() override
+    {
+        if (s_active == this)
+        {
+            s_active = nullptr;
+        }
+    }
+
+    /// The profiler installed in the current simulation, or nullptr.
+    static EventSourceProfiler* GetActive()
+    {
+        return s_active;
+    }
+
+    void SetScheduler(TypeId type)
+    {
+        ObjectFactory factory;
+        factory.SetTypeId(type);
+        m_scheduler = factory.Create<Scheduler>();
+    }
+
+    void Insert(const Event& ev) override
+    {
+        m_scheduler->Insert(ev);
+    }
+
+    bool IsEmpty() const override
+    {
+        // The run loop asks right after every event, so this ends the current handler.
+        Close();
+        return m_scheduler->IsEmpty();
+    }
+
+    Event PeekNext() const override
+    {
+        return m_scheduler->PeekNext();
+    }
+
+    Event RemoveNext() override
+    {
+        Close();
+        Event ev = m_scheduler->RemoveNext();
+        Source& source = m_sources[std::type_index(typeid(*ev.impl))];
+        ++source.events;
+        source.cancelled += ev.impl->IsCancelled() ? 1 : 0;
+        m_current = &source;
+        m_started = Clock::now();
+        return ev;
+    }
+
+    void Remove(const Event& ev) override
+    {
+        m_scheduler->Remove(ev);
+    }
+
+    /// Prints the event count and handler wall time per category and of the @p top sources.
+    void Print(std::ostream& os, const std::string& linePrefix, uint32_t top) const
+    {
+        Close();
+        struct Row
+        {
+            std::string category;
+            std::string label;
+            uint64_t events;
+            uint64_t cancelled;
+            double seconds;
+        };
+
+        std::vector<Row> rows;
+        std::map<std::string, Row> categories;
+        uint64_t events = 0;
+        double seconds = 0.0;
+        for (const auto& [type, source] : m_sources)
+        {
+            const std::string name = Demangle(type.name());
+            Row row{Categorize(name), Label(name), source.events, source.cancelled, source.seconds};
+            Row& category = categories.emplace(row.category, Row{row.category, "", 0, 0, 0.0}).first->second;
+            category.events += row.events;
+            category.cancelled += row.cancelled;
+            category.seconds += row.seconds;
+            events += row.events;
+            seconds += row.seconds;
+            rows.push_back(row);
+        }
+        std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) { return a.seconds > b.seconds; });
+        std::vector<Row> totals;
+        for (const auto& [name, row] : categories)
+        {
+            totals.push_back(row);
+        }
+        std::sort(totals.begin(), totals.end(), [](const Row& a, const Row& b) { return a.seconds > b.seconds; });
+
+        auto printRow = [&](const Row& row) {
+            os << linePrefix << "  " << std::left << std::setw(12) << row.category << std::right
+               << std::setw(12) << row.events << std::setw(11) << row.cancelled << std::fixed
+               << std::setprecision(1) << std::setw(8) << (events > 0 ? 100.0 * row.events / events : 0.0)
+               << std::setw(11) << row.seconds * 1e3 << std::setw(7)
+               << (seconds > 0.0 ? 100.0 * row.seconds / seconds : 0.0) << std::setw(10)
+               << (row.events > 0 ? row.seconds * 1e9 / row.events : 0.0) << std::defaultfloat
+               << std::setprecision(6) << "  " << row.label << std::endl;
+        };
+        auto printHeader = [&]() {
+            os << linePrefix << "  " << std::left << std::setw(12) << "category" << std::right
+               << std::setw(12) << "events" << std::setw(11) << "cancelled" << std::setw(8) << "ev%"
+               << std::setw(11) << "wall ms" << std::setw(7) << "wall%" << std::setw(10) << "ns/event"
+               << "  source" << std::endl;
+        };
+
+        os << linePrefix << "Event sources: " << events << " events, " << seconds * 1e3
+           << " ms in handlers" << std::endl;
+        printHeader();
+        for (const Row& row : totals)
+        {
+            printRow(row);
+        }
+        os << linePrefix << "Top " << std::min<size_t>(top, rows.size()) << " of " << rows.size()
+           << " event sources by wall time:" << std::endl;
+        printHeader();
+        for (size_t i = 0; i < rows.size() && i < top; ++i)
+        {
+            printRow(rows[i]);
+        }
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Source
+    {
+        uint64_t events = 0;
+        uint64_t cancelled = 0;
+        double seconds = 0.0;
+    };
+
+    void Close() const
+    {
+        if (m_current)
+        {
+            m_current->seconds += std::chrono::duration<double>(Clock::now() - m_started).count();
+            m_current = nullptr;
+        }
+    }
+
+    static std::string Demangle(const char* mangled)
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+        std::string name = status == 0 ? demangled : mangled;
+        std::free(demangled);
+        return name;
+    }
+
+    /// Template arguments of MakeEvent (the handler and its bound arguments), without "ns3::".
+    static std::string Label(const std::string& name)
+    {
+        std::string label = name;
+        const size_t open = name.find("MakeEvent<");
+        if (open != std::string::npos)
+        {
+            const size_t begin = open + 10;
+            size_t end = begin;
+            for (int depth = 1; end < name.size() && depth > 0; ++end)
+            {
+                depth += name[end] == '<' ? 1 : name[end] == '>' ? -1 : 0;
+            }
+            label = name.substr(begin, end - begin - 1);
+        }
+        for (size_t pos; (pos = label.find("ns3::")) != std::string::npos;)
+        {
+            label.erase(pos, 5);
+        }
+        return label.size() > 110 ? label.substr(0, 107) + "..." : label;
+    }
+
+    /// Class of a member-function handler, otherwise the whole name.
+    static std::string Owner(const std::string& name)
+    {
+        const size_t member = name.find("::*)");
+        if (member == std::string::npos)
+        {
+            return name;
+        }
+        const size_t open = name.rfind('(', member);
+        return name.substr(open + 1, member - open - 1);
+    }
+
+    static std::string Categorize(const std::string& name)
+    {
+        // First match wins, so the more specific names come first.
+        static const std::vector<std::pair<std::string, std::string>> rules = {
+            {"AnimationInterface", "netanim"},
+            {"FlowMonitor", "monitoring"},
+            {"FlowProbe", "monitoring"},
+            {"FlowTimeSeriesSampler", "monitoring"},
+            {"ConvergenceMonitor", "monitoring"},
+            {"ShowProgress", "monitoring"},
+            {"Mobility", "mobility"},
+            {"YansWifiChannel", "channel"},
+            // YansWifiChannel::Receive is a static function taking the receiving PHY.
+            {"(*)(ns3::Ptr<ns3::YansWifiPhy>", "channel"},
+            {"Phy", "phy"},
+            {"Interference", "phy"},
+            {"Mac", "mac"},
+            {"Txop", "mac"},
+            {"FrameExchange", "mac"},
+            {"ChannelAccessManager", "mac"},
+            {"BlockAck", "mac"},
+            {"RemoteStation", "mac"},
+            {"WifiNetDevice", "mac"},
+            {"Application", "application"},
+            {"UdpClient", "application"},
+            {"UdpServer", "application"},
+            {"Ipv4", "internet"},
+            {"Arp", "internet"},
+            {"Udp", "internet"},
+            {"Socket", "internet"},
+        };
+        const std::string owner = Owner(name);
+        for (const auto& [pattern, category] : rules)
+        {
+            if (owner.find(pattern) != std::string::npos)
+            {
+                return category;
+            }
+        }
+        return "other";
+    }
+
+    inline static EventSourceProfiler* s_active = nullptr;
+
+    Ptr<Scheduler> m_scheduler;
+    std::unordered_map<std::type_index, Source> m_sources;
+    mutable Source* m_current = nullptr;
+    mutable Clock::time_point m_started;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
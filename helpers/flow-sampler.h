@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef FLOW_SAMPLER_H
+#define FLOW_SAMPLER_H
+
+#include "ns3/core-module.h"
+#include "ns3/flow-monitor-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+namespace flow_sampler
+{
+// Header-only, so an inline variable stands in for NS_LOG_COMPONENT_DEFINE.
+inline LogComponent g_log("FlowTimeSeriesSampler", __FILE__);
+} // namespace flow_sampler
+
+/**
+ * Periodic per-flow snapshots of the cumulative FlowMonitor counters.
+ *
+ * Every interval the sampler copies rx bytes, rx/tx packets, delay sum and lost packets of
+ * every flow into fixed-size ring buffers sized for the whole run, so sampling never
+ * allocates (a flow's columns are allocated once, when it first shows up). If the run lasts
+ * longer than planned the oldest samples are overwritten. FlowMonitor::ResetAllStats (the
+ * warm-up) restarts the counters, which shows up as a drop in the series.
+ *
+ * Dump() writes little-endian binary columns:
+ *   char[8] "NS3FTSER", uint16 version, uint16 reserved, uint32 flow count F,
+ *   uint32 sample count S, int64 interval (ns), uint32 flowId[F], int64 time (ns)[S],
+ *   then per flow: uint64 rxBytes[S], uint32 rxPackets[S], uint32 txPackets[S],
+ *   int64 delaySum (ns)[S], uint32 lostPackets[S].
+ * flowmon_binary.py reads it. A file that cannot be written is logged
+ * (FlowTimeSeriesSampler, warn) and skipped.
+ */
+class FlowTimeSeriesSampler
+{
+  public:
+    FlowTimeSeriesSampler(Ptr<FlowMonitor> monitor, Time interval, Time duration, uint32_t expectedFlows)
+        : m_monitor(monitor),
+          m_interval(interval),
+          m_capacity(static_cast<uint32_t>(std::ceil(duration.GetSeconds() / interval.GetSeconds())) + 1),
+          m_times(m_capacity, 0)
+    {
+        m_flows.reserve(expectedFlows);
+        m_flowIndex.reserve(expectedFlows + 1);
+    }
+
+    void Start(Time start)
+    {
+        Simulator::Schedule(start, &FlowTimeSeriesSampler::Sample, this);
+    }
+
+    void Dump(const std::string& path) const
+    {
+        using namespace flow_sampler;
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            NS_LOG_WARN("Cannot write " << path);
+            return;
+        }
+        const uint32_t samples = std::min<uint64_t>(m_taken, m_capacity);
+        const uint32_t first = m_taken > m_capacity ? m_taken % m_capacity : 0;
+
+        out.write("NS3FTSER", 8);
+        Put(out, static_cast<uint16_t>(1));
+        Put(out, static_cast<uint16_t>(0));
+        Put(out, static_cast<uint32_t>(m_flows.size()));
+        Put(out, samples);
+        Put(out, m_interval.GetNanoSeconds());
+        for (const FlowSeries& flow : m_flows)
+        {
+            Put(out, flow.id);
+        }
+        WriteColumn(out, m_times, first, samples);
+        for (const FlowSeries& flow : m_flows)
+        {
+            WriteColumn(out, flow.rxBytes, first, samples);
+            WriteColumn(out, flow.rxPackets, first, samples);
+            WriteColumn(out, flow.txPackets, first, samples);
+            WriteColumn(out, flow.delaySum, first, samples);
+            WriteColumn(out, flow.lostPackets, first, samples);
+        }
+        out.close();
+        if (!out)
+        {
+            NS_LOG_WARN("Failed to write " << path);
+        }
+    }
+
+  private:
+    struct FlowSeries
+    {
+        explicit FlowSeries(FlowId flowId, uint32_t capacity)
+            : id(flowId),
+              rxBytes(capacity, 0),
+              rxPackets(capacity, 0),
+              txPackets(capacity, 0),
+              delaySum(capacity, 0),
+              lostPackets(capacity, 0)
+        {
+        }
+
+        FlowId id;
+        std::vector<uint64_t> rxBytes;
+        std::vector<uint32_t> rxPackets;
+        std::vector<uint32_t> txPackets;
+        std::vector<int64_t> delaySum;
+        std::vector<uint32_t> lostPackets;
+    };
+
+    void Sample()
+    {
+        const uint32_t slot = m_taken % m_capacity;
+        m_times[slot] = Simulator::Now().GetNanoSeconds();
+        for (const auto& [flowId, stats] : m_monitor->GetFlowStats())
+        {
+            FlowSeries& flow = Series(flowId);
+            flow.rxBytes[slot] = stats.rxBytes;
+            flow.rxPackets[slot] = stats.rxPackets;
+            flow.txPackets[slot] = stats.txPackets;
+            flow.delaySum[slot] = stats.delaySum.GetNanoSeconds();
+            flow.lostPackets[slot] = stats.lostPackets;
+        }
+        ++m_taken;
+        Simulator::Schedule(m_interval, &FlowTimeSeriesSampler::Sample, this);
+    }
+
+    FlowSeries& Series(FlowId flowId)
+    {
+        if (flowId >= m_flowIndex.size())
+        {
+            m_flowIndex.resize(flowId + 1, -1);
+        }
+        if (m_flowIndex[flowId] < 0)
+        {
+            m_flowIndex[flowId] = m_flows.size();
+            m_flows.emplace_back(flowId, m_capacity);
+        }
+        return m_flows[m_flowIndex[flowId]];
+    }
+
+    template <typename T>
+    static void Put(std::ofstream& out, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+        {
+            out.put(static_cast<char>(static_cast<uint64_t>(value) >> (8 * i)));
+        }
+    }
+
+    template <typename T>
+    static void WriteColumn(std::ofstream& out, const std::vector<T>& column, uint32_t first, uint32_t samples)
+    {
+        for (uint32_t i = 0; i < samples; ++i)
+        {
+            Put(out, column[(first + i) % column.size()]);
+        }
+    }
+
+    Ptr<FlowMonitor> m_monitor;
+    Time m_interval;
+    uint32_t m_capacity;
+    uint64_t m_taken = 0;
+    std::vector<int64_t> m_times;
+    std::vector<FlowSeries> m_flows;
+    std::vector<int32_t> m_flowIndex; // FlowId -> position in m_flows, -1 if not seen yet
+};
+
+} // namespace ns3
+
+#endif /* FLOW_SAMPLER_H */
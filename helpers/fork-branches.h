@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef FORK_BRANCHES_H
+#define FORK_BRANCHES_H
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+/**
+ * Forks one child per label from inside a running simulation (call it from a scheduled
+ * event). Each child returns its branch index and continues the event loop from the
+ * current state. The parent stays frozen at the branch point, keeps at most maxParallel
+ * children alive, waits for all of them and returns -1; failedBranches receives the
+ * number of children that did not exit with status 0.
+ *
+ * Only the single-threaded default simulator is safe to fork. Files opened before the
+ * branch point (NetAnim, pcap) are shared by all children and must be disabled.
+ */
+inline int
+ForkBranches(const std::vector<std::string>& labels, uint32_t maxParallel, uint32_t& failedBranches)
+{
+    failedBranches = 0;
+    std::map<pid_t, uint32_t> running;
+
+    auto reapOne = [&]() {
+        int status = 0;
+        const pid_t pid = waitpid(-1, &status, 0);
+        if (pid <= 0)
+        {
+            return;
+        }
+        auto it = running.find(pid);
+        if (it == running.end())
+        {
+            return;
+        }
+        const bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        if (!ok)
+        {
+            ++failedBranches;
+        }
+        std::cout << "Branch " << labels[it->second] << ": "
+                  << (ok ? "finished" : "FAILED") << std::endl;
+        running.erase(it);
+    };
+
+    for (uint32_t i = 0; i < labels.size(); ++i)
+    {
+        while (running.size() >= std::max<uint32_t>(maxParallel, 1))
+        {
+            reapOne();
+        }
+        // Buffered output would otherwise be written once by every child.
+        std::cout.flush();
+        std::fflush(stdout);
+        const pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork failed: " << std::strerror(errno));
+        if (pid == 0)
+        {
+            return static_cast<int>(i);
+        }
+        running[pid] = i;
+    }
+    while (!running.empty())
+    {
+        reapOne();
+    }
+    return -1;
+}
+
+} // namespace ns3
+
+#endif /* FORK_BRANCHES_H */
@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef MAC_FLOW_MONITOR_H
+#define MAC_FLOW_MONITOR_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * FlowMonitor counterpart for traffic sent over packet sockets, without an IP stack.
+ *
+ * Every flow is one sending application (with a "Tx" trace, like PacketSocketClient or
+ * BackloggedClient) on a STA; the receiving AP gets a protocol handler for PROTOCOL on its
+ * device, so no socket or application runs there. Packets are matched by their uid, which the
+ * Wi-Fi MAC keeps through aggregation and retransmissions. The counters follow FlowMonitor:
+ * delay and jitter sums over received packets, and packets still undelivered after
+ * MaxDelay are lost, checked every second and by CheckForLostPackets(). Packets the sending
+ * MAC drops (full queue, lifetime expiry, retry limit) are lost at once, as FlowMonitor's
+ * drop probes count them. The monitor must live until Simulator::Destroy().
+ */
+class MacFlowMonitor
+{
+  public:
+    /// EtherType of the generated frames (IEEE 802 local experimental).
+    static constexpr uint16_t PROTOCOL = 0x88B5;
+
+    struct FlowStats
+    {
+        uint64_t txPackets = 0;
+        uint64_t txBytes = 0;
+        uint64_t rxPackets = 0;
+        uint64_t rxBytes = 0;
+        uint64_t lostPackets = 0;
+        Time delaySum;
+        Time jitterSum;
+    };
+
+    explicit MacFlowMonitor(Time maxDelay = Seconds(10))
+        : m_maxDelay(maxDelay)
+    {
+        Simulator::Schedule(Seconds(1), &MacFlowMonitor::PeriodicCheck, this);
+    }
+
+    MacFlowMonitor(const MacFlowMonitor&) = delete;
+    MacFlowMonitor& operator=(const MacFlowMonitor&) = delete;
+
+    /// Flow of packets @p sender sends from @p device; returns the index for Get().
+    uint32_t AddFlow(Ptr<NetDevice> device, Ptr<Application> sender)
+    {
+        m_flows.push_back(std::make_unique<Flow>());
+        Flow* flow = m_flows.back().get();
+        m_bySource[Mac48Address::ConvertFrom(device->GetAddress())] = flow;
+        NS_ABORT_MSG_IF(!sender->TraceConnectWithoutContext("Tx", MakeCallback(&Flow::Sent, flow)),
+                        "MacFlowMonitor needs a sender with a Tx trace source");
+        if (Ptr<WifiNetDevice> wifi = DynamicCast<WifiNetDevice>(device))
+        {
+            wifi->GetMac()->TraceConnectWithoutContext("DroppedMpdu", MakeCallback(&Flow::Dropped, flow));
+        }
+        return m_flows.size() - 1;
+    }
+
+    /// Counts the PROTOCOL frames @p device receives.
+    void TrackReceiver(Ptr<NetDevice> device)
+    {
+        device->GetNode()->RegisterProtocolHandler(MakeCallback(&MacFlowMonitor::Received, this), PROTOCOL, device);
+    }
+
+    /// Zeroes the counters, like FlowMonitor::ResetAllStats; packets in flight stay tracked.
+    void ResetAllStats()
+    {
+        for (const std::unique_ptr<Flow>& flow : m_flows)
+        {
+            flow->stats = FlowStats();
+            flow->lastDelay = Time();
+        }
+    }
+
+    /// Counts every packet older than MaxDelay as lost.
+    void CheckForLostPackets()
+    {
+        const Time oldest = Simulator::Now() - m_maxDelay;
+        for (const std::unique_ptr<Flow>& flow : m_flows)
+        {
+            // uids grow with every new packet, so the oldest ones come first
+            while (!flow->inFlight.empty() && flow->inFlight.begin()->second < oldest)
+            {
+                flow->inFlight.erase(flow->inFlight.begin());
+                ++flow->stats.lostPackets;
+            }
+        }
+    }
+
+    const FlowStats& Get(uint32_t index) const
+    {
+        return m_flows[index]->stats;
+    }
+
+  private:
+    struct Flow
+    {
+        FlowStats stats;
+        Time lastDelay;
+        std::map<uint64_t, Time> inFlight; // packet uid -> send time
+
+        void Sent(Ptr<const Packet> packet, const Address& /* to */)
+        {
+            ++stats.txPackets;
+            stats.txBytes += packet->GetSize();
+            inFlight.emplace(packet->GetUid(), Simulator::Now());
+        }
+
+        void Dropped(WifiMacDropReason /* reason */, Ptr<const WifiMpdu> mpdu)
+        {
+            if (!mpdu->IsAggregate())
+            {
+                Lost(mpdu->GetPacket()->GetUid());
+                return;
+            }
+            for (const auto& msdu : *mpdu)
+            {
+                Lost(msdu.first->GetUid());
+            }
+        }
+
+        void Lost(uint64_t uid)
+        {
+            // management frames and packets of other senders are not in the map
+            if (inFlight.erase(uid) > 0)
+            {
+                ++stats.lostPackets;
+            }
+        }
+    };
+
+    void Received(Ptr<NetDevice> /* device */,
+                  Ptr<const Packet> packet,
+                  uint16_t /* protocol */,
+                  const Address& from,
+                  const Address& /* to */,
+                  NetDevice::PacketType /* type */)
+    {
+        auto source = m_bySource.find(Mac48Address::ConvertFrom(from));
+        if (source == m_bySource.end())
+        {
+            return;
+        }
+        Flow& flow = *source->second;
+        auto sent = flow.inFlight.find(packet->GetUid());
+        if (sent == flow.inFlight.end())
+        {
+            return; // a duplicate, or already counted as lost
+        }
+        const Time delay = Simulator::Now() - sent->second;
+        flow.inFlight.erase(sent);
+        FlowStats& stats = flow.stats;
+        if (stats.rxPackets > 0)
+        {
+            stats.jitterSum += Abs(delay - flow.lastDelay);
+        }
+        flow.lastDelay = delay;
+        stats.delaySum += delay;
+        ++stats.rxPackets;
+        stats.rxBytes += packet->GetSize();
+    }
+
+    void PeriodicCheck()
+    {
+        CheckForLostPackets();
+        Simulator::Schedule(Seconds(1), &MacFlowMonitor::PeriodicCheck, this);
+    }
+
+    Time m_maxDelay;
+    std::vector<std::unique_ptr<Flow>> m_flows;
+    std::map<Mac48Address, Flow*> m_bySource;
+};
+
+} // namespace ns3
+
+#endif /* MAC_FLOW_MONITOR_H */
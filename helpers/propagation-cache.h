@@ -0,0 +1,221 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef PROPAGATION_CACHE_H
+#define PROPAGATION_CACHE_H
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+namespace propagation_cache
+{
+// Header-only, so an inline variable stands in for NS_LOG_COMPONENT_DEFINE.
+inline LogComponent g_log("PropagationCache", __FILE__);
+} // namespace propagation_cache
+
+/**
+ * Per-pair matrix of a propagation result between nodes that do not move.
+ *
+ * Only pairs of ConstantPositionMobilityModels are cached; a CourseChange of either (a
+ * SetPosition) clears the matrix. The first value of every pair is computed twice: if the two
+ * differ the wrapped model is random, and the cache turns itself off for good.
+ */
+template <typename Entry>
+class StaticPairCache
+{
+  public:
+    /// Entry of the pair (@p a, @p b), or nullptr if the pair cannot be cached.
+    Entry* Find(const Ptr<MobilityModel>& a, const Ptr<MobilityModel>& b)
+    {
+        if (!m_enabled)
+        {
+            return nullptr;
+        }
+        // YansWifiChannel::Send asks for one sender and every receiver in turn
+        if (PeekPointer(a) != m_lastSender)
+        {
+            m_lastSender = PeekPointer(a);
+            m_lastRow = Index(a);
+        }
+        const int32_t row = m_lastRow;
+        const int32_t column = Index(b);
+        if (row < 0 || column < 0)
+        {
+            return nullptr;
+        }
+        if (m_entries.size() <= static_cast<size_t>(row))
+        {
+            m_entries.resize(row + 1);
+        }
+        std::vector<Entry>& entries = m_entries[row];
+        if (entries.size() <= static_cast<size_t>(column))
+        {
+            entries.resize(column + 1);
+        }
+        return &entries[column];
+    }
+
+    /// Called with two computations of the same pair; returns false once they ever differ.
+    template <typename T>
+    bool CheckDeterministic(const T& first, const T& second)
+    {
+        using namespace propagation_cache;
+        if (first != second)
+        {
+            NS_LOG_WARN("Propagation model is not deterministic, per-pair cache disabled");
+            m_enabled = false;
+            m_entries.clear();
+        }
+        return m_enabled;
+    }
+
+  private:
+    int32_t Index(const Ptr<MobilityModel>& model)
+    {
+        const MobilityModel* key = PeekPointer(model);
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            int32_t index = -1;
+            if (DynamicCast<ConstantPositionMobilityModel>(model))
+            {
+                index = m_index.size();
+                model->TraceConnectWithoutContext("CourseChange",
+                                                  MakeCallback(&StaticPairCache::Moved, this));
+            }
+            it = m_index.emplace(key, index).first;
+        }
+        return it->second;
+    }
+
+    void Moved(Ptr<const MobilityModel> /* model */)
+    {
+        m_entries.clear();
+    }
+
+    bool m_enabled = true;
+    std::unordered_map<const MobilityModel*, int32_t> m_index; // -1: not static
+    const MobilityModel* m_lastSender = nullptr;
+    int32_t m_lastRow = -1; // Index(m_lastSender)
+    std::vector<std::vector<Entry>> m_entries;
+};
+
+/**
+ * Caches the received power of a wrapped loss model (with its whole chain) per static node
+ * pair. Entries remember the transmit power they were computed for, so the result is the
+ * one the wrapped model returns, bit for bit; a different power recomputes the entry.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::CachedPropagationLossModel")
+                                .SetParent<PropagationLossModel>()
+                                .SetGroupName("Propagation")
+                                .AddConstructor<CachedPropagationLossModel>();
+        return tid;
+    }
+
+    void SetModel(Ptr<PropagationLossModel> model)
+    {
+        m_model = model;
+    }
+
+  private:
+    struct Entry
+    {
+        bool valid = false;
+        double txPowerDbm = 0.0;
+        double rxPowerDbm = 0.0;
+    };
+
+    double DoCalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const override
+    {
+        Entry* entry = m_cache.Find(a, b);
+        if (!entry)
+        {
+            return m_model->CalcRxPower(txPowerDbm, a, b);
+        }
+        if (!entry->valid || entry->txPowerDbm != txPowerDbm)
+        {
+            const double rxPowerDbm = m_model->CalcRxPower(txPowerDbm, a, b);
+            if (!m_cache.CheckDeterministic(rxPowerDbm, m_model->CalcRxPower(txPowerDbm, a, b)))
+            {
+                return rxPowerDbm;
+            }
+            *entry = Entry{true, txPowerDbm, rxPowerDbm};
+        }
+        return entry->rxPowerDbm;
+    }
+
+    int64_t DoAssignStreams(int64_t stream) override
+    {
+        return m_model->AssignStreams(stream);
+    }
+
+    Ptr<PropagationLossModel> m_model;
+    mutable StaticPairCache<Entry> m_cache;
+};
+
+/// Caches the propagation delay of a wrapped delay model per static node pair.
+class CachedPropagationDelayModel : public PropagationDelayModel
+{
+  public:
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::CachedPropagationDelayModel")
+                                .SetParent<PropagationDelayModel>()
+                                .SetGroupName("Propagation")
+                                .AddConstructor<CachedPropagationDelayModel>();
+        return tid;
+    }
+
+    void SetModel(Ptr<PropagationDelayModel> model)
+    {
+        m_model = model;
+    }
+
+    Time GetDelay(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const override
+    {
+        Entry* entry = m_cache.Find(a, b);
+        if (!entry)
+        {
+            return m_model->GetDelay(a, b);
+        }
+        if (!entry->valid)
+        {
+            const Time delay = m_model->GetDelay(a, b);
+            if (!m_cache.CheckDeterministic(delay, m_model->GetDelay(a, b)))
+            {
+                return delay;
+            }
+            *entry = Entry{true, delay};
+        }
+        return entry->delay;
+    }
+
+  private:
+    struct Entry
+    {
+        bool valid = false;
+        Time delay;
+    };
+
+    int64_t DoAssignStreams(int64_t stream) override
+    {
+        return m_model->AssignStreams(stream);
+    }
+
+    Ptr<PropagationDelayModel> m_model;
+    mutable StaticPairCache<Entry> m_cache;
+};
+
+} // namespace ns3
+
+#endif /* PROPAGATION_CACHE_H */
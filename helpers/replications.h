@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef REPLICATIONS_H
+#define REPLICATIONS_H
+
+#include "convergence-monitor.h"
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+/// Mean, sample standard deviation and 95 % CI half-width of independent replications.
+struct SampleSummary
+{
+    double mean = 0.0;
+    double stddev = 0.0;
+    double ciHalfWidth = 0.0;
+};
+
+inline SampleSummary
+Summarize(const std::vector<double>& samples)
+{
+    SampleSummary summary;
+    if (samples.empty())
+    {
+        return summary;
+    }
+    for (double sample : samples)
+    {
+        summary.mean += sample;
+    }
+    summary.mean /= samples.size();
+    if (samples.size() < 2)
+    {
+        return summary;
+    }
+    double variance = 0.0;
+    for (double sample : samples)
+    {
+        variance += (sample - summary.mean) * (sample - summary.mean);
+    }
+    summary.stddev = std::sqrt(variance / (samples.size() - 1));
+    summary.ciHalfWidth = ConvergenceMonitor::StudentT95(samples.size() - 1) * summary.stddev /
+                          std::sqrt(static_cast<double>(samples.size()));
+    return summary;
+}
+
+/**
+ * Runs job(0) ... job(jobs - 1) in up to @p workers forked processes and returns the
+ * strings the jobs produced, in job order. Worker k runs jobs k, k + workers, ...; call it
+ * before any simulation is set up so every worker starts from a clean simulator.
+ * Aborts if a worker fails.
+ */
+inline std::vector<std::string>
+RunInWorkers(uint32_t jobs, uint32_t workers, const std::function<std::string(uint32_t)>& job)
+{
+    workers = std::max<uint32_t>(1, std::min(workers, jobs));
+    std::vector<std::string> results(jobs);
+    std::vector<pid_t> pids;
+    std::vector<int> fds;
+
+    std::cout.flush();
+    std::fflush(stdout);
+    for (uint32_t worker = 0; worker < workers; ++worker)
+    {
+        int fd[2];
+        NS_ABORT_MSG_IF(pipe(fd) != 0, "pipe failed: " << std::strerror(errno));
+        const pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork failed: " << std::strerror(errno));
+        if (pid == 0)
+        {
+            close(fd[0]);
+            for (uint32_t index = worker; index < jobs; index += workers)
+            {
+                const std::string payload = job(index);
+                std::ostringstream frame;
+                frame << index << " " << payload.size() << "\n" << payload;
+                const std::string data = frame.str();
+                size_t written = 0;
+                while (written < data.size())
+                {
+                    const ssize_t n = write(fd[1], data.data() + written, data.size() - written);
+                    if (n < 0 && errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (n < 0)
+                    {
+                        std::_Exit(1);
+                    }
+                    written += n;
+                }
+            }
+            close(fd[1]);
+            std::cout.flush();
+            std::fflush(stdout);
+            std::_Exit(0);
+        }
+        close(fd[1]);
+        pids.push_back(pid);
+        fds.push_back(fd[0]);
+    }
+
+    for (uint32_t worker = 0; worker < workers; ++worker)
+    {
+        std::string buffer;
+        char chunk[65536];
+        ssize_t n;
+        while ((n = read(fds[worker], chunk, sizeof(chunk))) != 0)
+        {
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            NS_ABORT_MSG_IF(n < 0, "read failed: " << std::strerror(errno));
+            buffer.append(chunk, n);
+        }
+        close(fds[worker]);
+
+        size_t pos = 0;
+        while (pos < buffer.size())
+        {
+            const size_t eol = buffer.find('\n', pos);
+            NS_ABORT_MSG_IF(eol == std::string::npos, "Truncated result from worker " << worker);
+            std::istringstream header(buffer.substr(pos, eol - pos));
+            uint32_t index = 0;
+            size_t size = 0;
+            header >> index >> size;
+            NS_ABORT_MSG_IF(index >= jobs || eol + 1 + size > buffer.size(),
+                            "Malformed result from worker " << worker);
+            results[index] = buffer.substr(eol + 1, size);
+            pos = eol + 1 + size;
+        }
+
+        int status = 0;
+        waitpid(pids[worker], &status, 0);
+        NS_ABORT_MSG_IF(!WIFEXITED(status) || WEXITSTATUS(status) != 0,
+                        "Replication worker " << worker << " failed");
+    }
+    return results;
+}
+
+} // namespace ns3
+
+#endif /* REPLICATIONS_H */
@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+#ifndef SCENARIO_PRESETS_H
+#define SCENARIO_PRESETS_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace ns3
+{
+
+// AirtimeLogger labels of the STA devices, as the former programs named them.
+enum class DeviceLabels
+{
+    STANDARD, // staDeviceLegacy, then staDeviceAx or staDevicesAx
+    AB,       // staDeviceA, then staDeviceB or one staDeviceB1, staDeviceB2, ... per STA
+    PLAIN,    // staDevice or staDevices (single-BSS presets)
+};
+
+/**
+ * The scenario_coex presets (the names of the former per-scenario programs) and the default
+ * data/control modes per standard, shared by scenario_coex and anomaly_predictor.
+ */
+struct ScenarioPreset
+{
+    const char* name;
+    const char* legacyStandard;
+    uint32_t legacyStaCount;
+    const char* modernStandard;
+    uint32_t modernStaCount;
+    const char* modernDataMode;
+    const char* modernControlMode;
+    double radius;
+    bool netAnim;
+    bool pcap;
+    bool legacyAssoc; // 802.11be STAs associate with AssocType=LEGACY
+    bool arpCache;    // ARP caches filled before the traffic starts
+    DeviceLabels labels;
+};
+
+// The triplesta and be_ax rows have no former program; they follow their dualsta/quadsta neighbours.
+// clang-format off
+inline const ScenarioPreset g_scenarioPresets[] = {
+    {"scenario_coex_a_ax",            "a",  1, "ax",  1, "",         "",       5.0, true,  true,  false, false, DeviceLabels::AB},
+    {"scenario_coex_a_ax_dualsta",    "a",  1, "ax",  2, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_a_ax_triplesta",  "a",  1, "ax",  3, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_a_ax_quadsta",    "a",  1, "ax",  4, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_a_ax_decsta",     "a",  1, "ax", 10, "",         "",       5.0, true,  false, false, true,  DeviceLabels::STANDARD},
+    {"scenario_coex_a_be",            "a",  1, "be",  1, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_a_be_dualsta",    "a",  1, "be",  2, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_a_be_quadsta",    "a",  1, "be",  4, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_a_be_decsta",     "a",  1, "be", 10, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_ac_ax",           "ac", 1, "ax",  1, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_ac_ax_dualsta",   "ac", 1, "ax",  2, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_ac_ax_triplesta", "ac", 1, "ax",  3, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_ac_ax_quadsta",   "ac", 1, "ax",  4, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_ac_ax_decsta",    "ac", 1, "ax", 10, "",         "",       5.0, true,  false, false, true,  DeviceLabels::STANDARD},
+    {"scenario_coex_ac_be",           "ac", 1, "be",  1, "",         "",       2.0, true,  false, false, true,  DeviceLabels::STANDARD},
+    {"scenario_coex_ac_be_dualsta",   "ac", 1, "be",  2, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_ac_be_quadsta",   "ac", 1, "be",  4, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_ac_be_decsta",    "ac", 1, "be", 10, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_n_ax",            "n",  1, "ax",  1, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_n_ax_dualsta",    "n",  1, "ax",  2, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_n_ax_triplesta",  "n",  1, "ax",  3, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_n_ax_quadsta",    "n",  1, "ax",  4, "",         "",       5.0, true,  false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_n_ax_decsta",     "n",  1, "ax", 10, "",         "",       5.0, true,  false, false, true,  DeviceLabels::STANDARD},
+    {"scenario_coex_n_be",            "n",  1, "be",  1, "",         "",       2.0, true,  false, false, true,  DeviceLabels::STANDARD},
+    {"scenario_coex_n_be_dualsta",    "n",  1, "be",  2, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_n_be_quadsta",    "n",  1, "be",  4, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_n_be_decsta",     "n",  1, "be", 10, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_be_ax",           "be", 1, "ax",  1, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_be_ax_dualsta",   "be", 1, "ax",  2, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_be_ax_quadsta",   "be", 1, "ax",  4, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_be_ax_decsta",    "be", 1, "ax", 10, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::STANDARD},
+    {"scenario_coex_ax_2sta",         "ax", 1, "ax",  1, "",         "",       5.0, false, false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_ax_3sta",         "",   0, "ax",  3, "",         "",       5.0, false, false, false, true,  DeviceLabels::PLAIN},
+    {"scenario_coex_ax_5sta",         "",   0, "ax",  5, "",         "",       5.0, false, false, false, true,  DeviceLabels::PLAIN},
+    {"scenario_coex_ax_11sta",        "",   0, "ax", 11, "",         "",       5.0, false, false, false, true,  DeviceLabels::PLAIN},
+    {"scenario_coex_be_2sta",         "be", 1, "be",  1, "",         "",       2.0, false, false, false, true,  DeviceLabels::AB},
+    {"scenario_coex_be_3sta",         "",   0, "be",  3, "EhtMcs11", "EhtMcs0", 2.0, false, false, true,  true,  DeviceLabels::PLAIN},
+    {"scenario_coex_be_5sta",         "",   0, "be",  5, "EhtMcs11", "EhtMcs0", 2.0, false, false, true,  true,  DeviceLabels::PLAIN},
+    {"scenario_coex_be_11sta",        "",   0, "be", 11, "EhtMcs11", "EhtMcs0", 2.0, false, false, true,  true,  DeviceLabels::PLAIN},
+    {"scenario_single_ax",            "",   0, "ax",  1, "",         "",       5.0, true,  false, false, true,  DeviceLabels::PLAIN},
+    {"scenario_single_be",            "",   0, "be",  1, "",         "",       2.0, true,  false, true,  true,  DeviceLabels::PLAIN},
+};
+// clang-format on
+
+inline const ScenarioPreset*
+FindPreset(const std::string& name)
+{
+    for (const auto& preset : g_scenarioPresets)
+    {
+        if (name == preset.name)
+        {
+            return &preset;
+        }
+    }
+    return nullptr;
+}
+
+// The preset has to be known before CommandLine::Parse so that explicit options can override it.
+inline std::string
+FindScenarioArgument(int argc, char* argv[], const std::string& fallback)
+{
+    const std::string prefix = "--scenario=";
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        if (arg.rfind(prefix, 0) == 0)
+        {
+            return arg.substr(prefix.size());
+        }
+    }
+    return fallback;
+}
+
+// Data and control modes used by the original scenarios for each standard.
+inline std::pair<std::string, std::string>
+DefaultModes(const std::string& standard)
+{
+    if (standard == "a")
+    {
+        return {"OfdmRate6Mbps", "OfdmRate6Mbps"};
+    }
+    if (standard == "n")
+    {
+        return {"HtMcs0", "HtMcs0"};
+    }
+    if (standard == "ac")
+    {
+        return {"VhtMcs0", "VhtMcs0"};
+    }
+    if (standard == "ax")
+    {
+        return {"HeMcs11", "HeMcs0"};
+    }
+    return {"EhtMcs13", "OfdmRate54Mbps"};
+}
+
+} // namespace ns3
+
+#endif /* SCENARIO_PRESETS_H */
@@ -8,6 +8,12 @@ LOG_DIR="$PROJECT_ROOT/scratch/logs"
 BE_MAX_AMPDU=4194304      # domyślna wartość w bajtach (0 wyłącza A-MPDU)  4194304 65535 262144
 SIMULATION_TIME=260     # domyślny czas symulacji (s)
 CLIENT_INTERVAL=0.0001  # domyślny odstęp między pakietami (s)
+TRACE_LEVEL="${TRACE_LEVEL:-full}"  # none / summary / sampled / full -- NetAnim, pcap i szczegóły FlowMonitor
+MAX_JOBS="${MAX_JOBS:-$(nproc 2>/dev/null || getconf _NPROCESSORS_ONLN)}"  # limit równoległych symulacji
+MEM_PER_JOB_MB="${MEM_PER_JOB_MB:-0}"  # szacowana pamięć jednej symulacji (MB, 0 wyłącza limit pamięci)
+RUNTIMES_FILE="$LOG_DIR/runtimes.tsv"   # czasy poprzednich przebiegów: scenariusz<TAB>sekundy
+CACHE_DIR="${CACHE_DIR:-$PROJECT_ROOT/scratch/cache}"  # wyniki poprzednich przebiegów, klucz = hash konfiguracji i builda
+USE_CACHE="${USE_CACHE:-1}"             # 0 wymusza ponowne uruchomienie wszystkich scenariuszy
 
 mkdir -p "$LOG_DIR"
 
@@ -55,19 +61,135 @@ SCENARIOS=(
   scenario_single_be
 )
 
-echo "Launching ${#SCENARIOS[@]} simulations..."
-
-for scenario in "${SCENARIOS[@]}"; do
-  log_file="$LOG_DIR/${scenario}.log"
-  echo "  -> $scenario (log: $log_file)"
-  (
-    cd "$PROJECT_ROOT"
-    ./ns3 run "$scenario" -- \
-      --beMaxAmpdu="$BE_MAX_AMPDU" \
-      --simulationTime="$SIMULATION_TIME" \
-      --clientInterval="$CLIENT_INTERVAL"
-  ) >"$log_file" 2>&1 &
+# Wszystkie scenariusze to presety jednego programu scenario_coex -- budujemy go raz.
+(cd "$PROJECT_ROOT" && ./ns3 build scenario_coex)
+
+SIM_ARGS=(
+  --beMaxAmpdu="$BE_MAX_AMPDU"
+  --simulationTime="$SIMULATION_TIME"
+  --clientInterval="$CLIENT_INTERVAL"
+  --traceLevel="$TRACE_LEVEL"
+)
+# Dodatkowe opcje scenario_coex, np. EXTRA_ARGS="--convergence=1 --convergencePrecision=0.02"
+read -r -a EXTRA_SIM_ARGS <<<"${EXTRA_ARGS:-}"
+SIM_ARGS+=("${EXTRA_SIM_ARGS[@]}")
+# Kolejka zdarzeń symulatora (map / heap / calendar / list); wyniki są identyczne, zmienia się tylko szybkość.
+if [[ -n "${SCHEDULER:-}" ]]; then
+  SIM_ARGS+=(--scheduler="$SCHEDULER")
+fi
+
+# Identyfikator builda: wersja ns-3, zawartość binarki scenario_coex i stan bibliotek ns-3.
+BUILD_ID=$(
+  {
+    cat "$PROJECT_ROOT/VERSION" 2>/dev/null || true
+    find "$PROJECT_ROOT/build" -type f -name '*scenario_coex*' -exec sha256sum {} + 2>/dev/null || true
+    find "$PROJECT_ROOT/build/lib" -name 'libns3*' -printf '%f %s %T@\n' 2>/dev/null || true
+  } | sort | sha256sum | cut -d' ' -f1
+)
+
+cache_key() {
+  printf '%s\n' "$BUILD_ID" "$1" "${SIM_ARGS[@]}" | sha256sum | cut -d' ' -f1
+}
+
+# Przywraca log, flowmon i rekord wyników z cache; zwraca 1, jeśli wpisu nie ma.
+restore_cached() {
+  local scenario="$1"
+  local entry="$CACHE_DIR/$(cache_key "$scenario")"
+  [[ "$USE_CACHE" == 1 && -f "$entry/${scenario}.log" ]] || return 1
+  cp "$entry/${scenario}.log" "$LOG_DIR/${scenario}.log"
+  local flowmon
+  for flowmon in "$entry/${scenario}.flowmon" "$entry/${scenario}.fmb"; do
+    [[ -f "$flowmon" ]] || continue
+    mkdir -p "$PROJECT_ROOT/scratch/flowmon"
+    cp "$flowmon" "$PROJECT_ROOT/scratch/flowmon/"
+  done
+  if [[ -f "$entry/${scenario}.jsonl" ]]; then
+    mkdir -p "$PROJECT_ROOT/scratch/results"
+    cp "$entry/${scenario}.jsonl" "$PROJECT_ROOT/scratch/results/"
+  fi
+}
+
+store_cached() {
+  local scenario="$1"
+  local entry="$CACHE_DIR/$(cache_key "$scenario")"
+  local tmp="$entry.tmp.$$"
+  mkdir -p "$tmp"
+  cp "$LOG_DIR/${scenario}.log" "$tmp/"
+  cp "$PROJECT_ROOT/scratch/flowmon/${scenario}.flowmon" "$tmp/" 2>/dev/null || true
+  cp "$PROJECT_ROOT/scratch/flowmon/${scenario}.fmb" "$tmp/" 2>/dev/null || true
+  cp "$PROJECT_ROOT/scratch/results/${scenario}.jsonl" "$tmp/" 2>/dev/null || true
+  rm -rf "$entry"
+  mv "$tmp" "$entry"
+}
+
+if (( MEM_PER_JOB_MB > 0 )); then
+  mem_available_mb=$(( $(awk '/^MemAvailable:/ {print $2}' /proc/meminfo) / 1024 ))
+  mem_jobs=$(( mem_available_mb / MEM_PER_JOB_MB ))
+  (( mem_jobs < 1 )) && mem_jobs=1
+  (( mem_jobs < MAX_JOBS )) && MAX_JOBS=$mem_jobs
+fi
+
+# Najdłuższe scenariusze startują pierwsze; scenariusze bez zapisanego czasu traktujemy jako najdłuższe.
+declare -A RUNTIMES=()
+if [[ -f "$RUNTIMES_FILE" ]]; then
+  while IFS=$'\t' read -r name seconds; do
+    RUNTIMES["$name"]=$seconds
+  done <"$RUNTIMES_FILE"
+fi
+
+mapfile -t ORDERED < <(
+  for scenario in "${SCENARIOS[@]}"; do
+    printf '%s\t%s\n' "${RUNTIMES[$scenario]:-999999999}" "$scenario"
+  done | sort -t $'\t' -k1,1nr | cut -f2
+)
+
+# Kolejka zadań: katalog-manifest, z którego zadania pobierają procesy sweep_executor.py.
+# Na innych maszynach ze wspólnym katalogiem wystarczy uruchomić w trakcie:
+#   python3 sweep_executor.py work --manifest "$MANIFEST_DIR"
+MANIFEST_DIR="${MANIFEST_DIR:-$PROJECT_ROOT/scratch/sweeps/run_all}"
+JOB_TIMEOUT="${JOB_TIMEOUT:-0}"    # limit czasu jednej symulacji (s, 0 wyłącza); po przekroczeniu zadanie wraca do kolejki
+JOB_ATTEMPTS="${JOB_ATTEMPTS:-2}"  # liczba prób, zanim zadanie zostanie uznane za nieudane
+
+FAILED=()
+CACHED=0
+TO_RUN=()
+
+echo "Launching ${#SCENARIOS[@]} simulations (max $MAX_JOBS at a time)..."
+
+for scenario in "${ORDERED[@]}"; do
+  if restore_cached "$scenario"; then
+    CACHED=$(( CACHED + 1 ))
+    echo "  [cached] $scenario"
+  else
+    TO_RUN+=("$scenario")
+  fi
 done
-wait
 
-echo "All simulations finished. Logs available under $LOG_DIR "
+if (( ${#TO_RUN[@]} > 0 )); then
+  # Kolejność w manifeście = kolejność TO_RUN, więc najdłuższe scenariusze nadal startują pierwsze.
+  python3 "$PROJECT_ROOT/sweep_executor.py" submit --fresh \
+    --manifest "$MANIFEST_DIR" --project-root "$PROJECT_ROOT" --log-dir "$LOG_DIR" \
+    --timeout "$JOB_TIMEOUT" --attempts "$JOB_ATTEMPTS" \
+    --scenario "${TO_RUN[@]}" --args="${SIM_ARGS[*]}"
+  python3 "$PROJECT_ROOT/sweep_executor.py" work --manifest "$MANIFEST_DIR" -j "$MAX_JOBS" || true
+
+  while IFS=$'\t' read -r scenario seconds; do
+    RUNTIMES["$scenario"]=${seconds%.*}
+    store_cached "$scenario"
+  done < <(python3 "$PROJECT_ROOT/sweep_executor.py" status --manifest "$MANIFEST_DIR" --list done)
+  while IFS=$'\t' read -r scenario result; do
+    FAILED+=("$scenario")
+  done < <(python3 "$PROJECT_ROOT/sweep_executor.py" status --manifest "$MANIFEST_DIR" --list failed)
+fi
+
+for name in "${!RUNTIMES[@]}"; do
+  printf '%s\t%s\n' "$name" "${RUNTIMES[$name]}"
+done | sort >"$RUNTIMES_FILE"
+
+if (( ${#FAILED[@]} > 0 )); then
+  echo "${#FAILED[@]} of ${#SCENARIOS[@]} simulations failed: ${FAILED[*]}"
+  echo "Logs available under $LOG_DIR"
+  exit 1
+fi
+
+echo "All simulations finished ($CACHED reused from $CACHE_DIR). Logs available under $LOG_DIR "
@@ -0,0 +1,1437 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Data-driven coexistence scenario.
+ *
+ * One or two BSSs share a single YansWifiChannel: an optional "legacy" BSS and a "modern" BSS.
+ * Each BSS has one AP at the origin and its STAs on a circle of radius r around it. Every STA
+ * sends saturated UDP uplink traffic to its AP; FlowMonitor collects throughput, delay and jitter.
+ * With --stack=raw the STAs send the same frames over packet sockets without an IP stack, and
+ * MacFlowMonitor collects the same per-STA statistics at the APs.
+ *
+ * --scenario selects one of the presets below (the names of the former per-scenario programs),
+ * every other option overrides the preset. Unknown scenario names are only used to label outputs.
+ *
+ *   ./ns3 run scenario_coex -- --scenario=scenario_coex_n_be_decsta --simulationTime=60
+ *   ./ns3 run scenario_coex -- --scenario=my_sweep --legacyStandard=ac --modernStandard=be --modernStaCount=6
+ *   ./ns3 run scenario_coex -- --scenario=scenario_coex_a_ax --replications=10 --parallel=4
+ */
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/flow-monitor-module.h"
+#include "ns3/netanim-module.h"
+#include "../helpers/populate-arp.h"
+#include "../helpers/airtime-breakdown.h"
+#include "../helpers/airtime-logger.h"
+#include "../helpers/backlogged-client.h"
+#include "../helpers/bounded-pcap.h"
+#include "../helpers/contention-stats.h"
+#include "../helpers/convergence-monitor.h"
+#include "../helpers/event-profiler.h"
+#include "../helpers/flow-sampler.h"
+#include "../helpers/flowmon-binary.h"
+#include "../helpers/fork-branches.h"
+#include "../helpers/mac-flow-monitor.h"
+#include "../helpers/propagation-cache.h"
+#include "../helpers/replications.h"
+#include "../helpers/scenario-presets.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("WifiCoexistenceScenario");
+
+namespace
+{
+
+struct BssSpec
+{
+    std::string standard;    // "a", "n", "ac", "ax" or "be"
+    uint32_t staCount;       // 0 disables the BSS
+    std::string dataMode;    // empty: default for the standard
+    std::string controlMode; // empty: default for the standard
+};
+
+// How much per-packet output a run produces; every level keeps the printed and JSON results.
+enum class TraceLevel
+{
+    NONE,    // no NetAnim, no pcap, no FlowMonitor XML
+    SUMMARY, // NetAnim topology only, FlowMonitor XML without histograms and probes
+    SAMPLED, // NetAnim packets and pcap only during traceWindow, FlowMonitor XML with histograms
+    FULL,    // NetAnim with packet metadata, pcap for the whole run, complete FlowMonitor XML
+};
+
+struct ScenarioConfig
+{
+    std::string name;
+    BssSpec legacy;
+    BssSpec modern;
+    double radius;
+    std::string channelSettings;
+    bool channelCache; // per-pair loss/delay matrix for the static nodes
+    bool netAnim;
+    bool pcap;
+    bool legacyAssoc;          // 802.11be STAs associate with AssocType=LEGACY
+    bool arpCache;             // fill the ARP caches before the traffic starts (stack=ip)
+    DeviceLabels deviceLabels; // AirtimeLogger labels of the STA devices
+    BoundedPcapOptions pcapLimits;
+    TraceLevel traceLevel;
+    double traceWindow;
+    bool flowmonXml;
+    double sampleInterval; // ms, 0 disables the time series
+    uint32_t eventProfile; // rows of the event-source table, 0 disables the profiler
+    std::string scheduler; // "map", "heap", "calendar" or "list"
+    uint32_t beMaxAmpdu;
+    double simulationTime;
+    std::string stack;      // "ip": IPv4/UDP with FlowMonitor, "raw": packet sockets with MacFlowMonitor
+    std::string traffic;    // "udp": UdpClient every clientInterval, "backlogged": BackloggedClient
+    double clientInterval;
+    uint32_t backlogThreshold; // MPDUs, 0: refill whenever the BE queue is not full
+    double warmup;
+    bool convergence;
+    double convergenceBatch;
+    double convergencePrecision;
+    uint32_t convergenceMinBatches;
+    double branchTime;
+    std::string branchParameter;
+    std::vector<std::string> branchValues;
+    uint32_t branchParallel;
+    uint32_t replications;
+    uint32_t parallel;
+};
+
+void
+ApplyPreset(const ScenarioPreset& preset, ScenarioConfig& config)
+{
+    config.legacy = {preset.legacyStandard, preset.legacyStaCount, "", ""};
+    config.modern = {preset.modernStandard,
+                     preset.modernStaCount,
+                     preset.modernDataMode,
+                     preset.modernControlMode};
+    config.radius = preset.radius;
+    config.netAnim = preset.netAnim;
+    config.pcap = preset.pcap;
+    config.legacyAssoc = preset.legacyAssoc;
+    config.arpCache = preset.arpCache;
+    config.deviceLabels = preset.labels;
+}
+
+WifiStandard
+ParseStandard(const std::string& standard)
+{
+    if (standard == "a")
+    {
+        return WIFI_STANDARD_80211a;
+    }
+    if (standard == "n")
+    {
+        return WIFI_STANDARD_80211n;
+    }
+    if (standard == "ac")
+    {
+        return WIFI_STANDARD_80211ac;
+    }
+    if (standard == "ax")
+    {
+        return WIFI_STANDARD_80211ax;
+    }
+    if (standard == "be")
+    {
+        return WIFI_STANDARD_80211be;
+    }
+    NS_ABORT_MSG("Unsupported Wi-Fi standard: 802.11" << standard);
+    return WIFI_STANDARD_UNSPECIFIED;
+}
+
+std::tuple<uint8_t, uint8_t, uint8_t>
+ApColor(const std::string& standard)
+{
+    if (standard == "a")
+    {
+        return {220, 20, 60}; // crimson
+    }
+    if (standard == "n")
+    {
+        return {34, 139, 34}; // forest green
+    }
+    if (standard == "ac")
+    {
+        return {138, 43, 226}; // blue violet
+    }
+    return {65, 105, 225}; // royal blue
+}
+
+std::tuple<uint8_t, uint8_t, uint8_t>
+StaColor(const std::string& standard, uint32_t index)
+{
+    if (standard == "a")
+    {
+        return {255, 99, 71}; // tomato
+    }
+    if (standard == "n")
+    {
+        return {60, 179, 113}; // medium sea green
+    }
+    if (standard == "ac")
+    {
+        return {186, 85, 211}; // medium orchid
+    }
+    static const std::vector<std::tuple<uint8_t, uint8_t, uint8_t>> modernColors = {
+        {135, 206, 250}, {70, 130, 180}, {25, 25, 112}, {0, 191, 255}, {30, 144, 255},
+        {123, 104, 238}, {72, 61, 139}, {0, 0, 205}, {95, 158, 160}, {176, 224, 230}};
+    return modernColors[index % modernColors.size()];
+}
+
+TraceLevel
+ParseTraceLevel(const std::string& level)
+{
+    if (level == "none")
+    {
+        return TraceLevel::NONE;
+    }
+    if (level == "summary")
+    {
+        return TraceLevel::SUMMARY;
+    }
+    if (level == "sampled")
+    {
+        return TraceLevel::SAMPLED;
+    }
+    if (level == "full")
+    {
+        return TraceLevel::FULL;
+    }
+    NS_ABORT_MSG("Unsupported trace level: " << level << " (none, summary, sampled or full)");
+    return TraceLevel::FULL;
+}
+
+std::string
+TraceLevelName(TraceLevel level)
+{
+    switch (level)
+    {
+    case TraceLevel::NONE:
+        return "none";
+    case TraceLevel::SUMMARY:
+        return "summary";
+    case TraceLevel::SAMPLED:
+        return "sampled";
+    case TraceLevel::FULL:
+        return "full";
+    }
+    return "full";
+}
+
+// Event queue implementation of the simulator; all keep equal-time events in FIFO order, so
+// the choice changes the speed but not the results.
+TypeId
+ParseScheduler(const std::string& scheduler)
+{
+    if (scheduler == "map")
+    {
+        return MapScheduler::GetTypeId();
+    }
+    if (scheduler == "heap")
+    {
+        return HeapScheduler::GetTypeId();
+    }
+    if (scheduler == "calendar")
+    {
+        return CalendarScheduler::GetTypeId();
+    }
+    if (scheduler == "list")
+    {
+        return ListScheduler::GetTypeId();
+    }
+    NS_ABORT_MSG("Unsupported scheduler: " << scheduler << " (map, heap, calendar or list)");
+    return MapScheduler::GetTypeId();
+}
+
+std::vector<std::string>
+SplitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        if (!item.empty())
+        {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// Parameters that can change after the network is up: the client rate and the BE A-MPDU limit.
+// The A-MPDU limit only affects what each device transmits from now on, not the capabilities
+// it advertised at association.
+void
+ApplyBranchValue(ScenarioConfig& config, const std::string& value, const ApplicationContainer& clientApps)
+{
+    if (config.branchParameter == "clientInterval")
+    {
+        config.clientInterval = std::stod(value);
+        for (uint32_t i = 0; i < clientApps.GetN(); ++i)
+        {
+            clientApps.Get(i)->SetAttribute("Interval", TimeValue(Seconds(config.clientInterval)));
+        }
+    }
+    else if (config.branchParameter == "beMaxAmpdu")
+    {
+        config.beMaxAmpdu = std::stoul(value);
+        Config::Set("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Mac/BE_MaxAmpduSize",
+                    UintegerValue(config.beMaxAmpdu));
+    }
+}
+
+// Every branch writes its own log, named like a regular run of the branched configuration.
+void
+RedirectBranchOutput(const std::string& name)
+{
+    std::error_code ec;
+    std::filesystem::create_directories("scratch/logs", ec);
+    const std::string path = "scratch/logs/" + name + ".log";
+    NS_ABORT_MSG_IF(!std::freopen(path.c_str(), "w", stdout), "Cannot open " << path);
+}
+
+struct Bss
+{
+    BssSpec spec;
+    std::string label;   // "802.11ax"
+    std::vector<std::string> devices; // AirtimeLogger label of all STAs, or one per STA
+    uint32_t firstSta;   // index of the first STA in the STA node container
+    NetDeviceContainer apDevice;
+    NetDeviceContainer staDevices;
+    Ipv4InterfaceContainer apInterface;
+    uint16_t firstPort;
+};
+
+struct FlowResult
+{
+    std::string label;       // "802.11ax STA #1", "802.11a network"
+    std::string bss;         // "legacy" or "modern"
+    std::string standard;    // "ax"
+    uint32_t sta = 0;        // 1-based index within the BSS
+    double throughput = 0.0; // Mbit/s
+    double avgDelay = 0.0;   // s
+    double avgJitter = 0.0;  // s
+    uint32_t txPackets = 0;
+    uint32_t rxPackets = 0;
+    uint32_t lostPackets = 0;
+    AirtimeBreakdown::Counters airtime; // the STA's radio during the measurement (transmitTotal: whole run)
+    ContentionStats::Histograms contention;
+};
+
+// Cost of one run, for sizing sweeps and spotting slowdowns between ns-3 versions.
+struct RunProfile
+{
+    double setupSeconds = 0.0; // wall clock from the start of RunScenario to Simulator::Run
+    double runSeconds = 0.0;   // wall clock spent in Simulator::Run
+    uint64_t events = 0;
+    double simulatedSeconds = 0.0;
+    long peakRssKb = 0; // of the whole process, so it never decreases across replications
+
+    double EventsPerSecond() const
+    {
+        return runSeconds > 0.0 ? events / runSeconds : 0.0;
+    }
+
+    double SimulatedPerWallSecond() const
+    {
+        return runSeconds > 0.0 ? simulatedSeconds / runSeconds : 0.0;
+    }
+};
+
+long
+PeakRssKb()
+{
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? usage.ru_maxrss : 0;
+}
+
+struct DeviceAirtime
+{
+    std::string label; // "AP 802.11ax"
+    AirtimeBreakdown::Counters airtime;
+};
+
+void
+PrintAirtimeBreakdown(const std::string& linePrefix,
+                      const std::vector<FlowResult>& results,
+                      const std::vector<DeviceAirtime>& accessPoints)
+{
+    std::cout << linePrefix
+              << "Airtime breakdown (s; data / retry / control / mgmt / unacked / rx / CCA busy / idle):"
+              << std::endl;
+    auto print = [&linePrefix](const std::string& label, const AirtimeBreakdown::Counters& a) {
+        std::cout << linePrefix << "  " << label << " - " << a.data << " / " << a.retry << " / " << a.control
+                  << " / " << a.management << " / " << a.unacknowledged << " / " << a.receive << " / "
+                  << a.ccaBusy << " / " << a.idle << std::endl;
+    };
+    for (const FlowResult& result : results)
+    {
+        print(result.label, result.airtime);
+    }
+    for (const DeviceAirtime& ap : accessPoints)
+    {
+        print(ap.label, ap.airtime);
+    }
+}
+
+std::string
+FormatHistogram(const Log2Histogram& histogram)
+{
+    std::ostringstream out;
+    for (uint32_t bucket = 0; bucket < Log2Histogram::BUCKETS; ++bucket)
+    {
+        if (histogram.GetCount(bucket) > 0)
+        {
+            out << (out.tellp() > 0 ? " " : "") << Log2Histogram::GetLabel(bucket) << ":"
+                << histogram.GetCount(bucket);
+        }
+    }
+    return out.tellp() > 0 ? out.str() : "-";
+}
+
+void
+PrintContention(const std::string& linePrefix, const std::vector<FlowResult>& results)
+{
+    std::cout << linePrefix << "MAC contention per STA (bucket:count):" << std::endl;
+    for (const FlowResult& result : results)
+    {
+        const ContentionStats::Histograms& h = result.contention;
+        std::cout << linePrefix << "  " << result.label << " - A-MPDU length " << FormatHistogram(h.ampduLength)
+                  << "; MPDU retries " << FormatHistogram(h.mpduRetries) << "; backoff slots "
+                  << FormatHistogram(h.backoffSlots) << "; acks";
+        for (uint32_t outcome = 0; outcome < ContentionStats::ACK_OUTCOMES; ++outcome)
+        {
+            std::cout << " " << ContentionStats::GetAckOutcomeName(outcome) << ":" << h.ackOutcomes[outcome];
+        }
+        std::cout << std::endl;
+    }
+}
+
+std::string
+JsonString(const std::string& value)
+{
+    std::ostringstream out;
+    out << '"';
+    for (char c : value)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                << std::dec << std::setfill(' ');
+        }
+        else
+        {
+            out << c;
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+/**
+ * Writes scratch/results/<scenario>.jsonl: one JSON record with the full configuration and
+ * the per-flow metrics, so post-processing does not have to parse the log.
+ */
+void
+WriteResultsRecord(const ScenarioConfig& config,
+                   const std::vector<FlowResult>& results,
+                   const std::vector<DeviceAirtime>& accessPoints,
+                   const RunProfile& profile,
+                   double trafficTime,
+                   double measuredTime,
+                   bool converged)
+{
+    std::error_code ec;
+    std::filesystem::create_directories("scratch/results", ec);
+    const std::string path = "scratch/results/" + config.name + ".jsonl";
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+    {
+        NS_LOG_WARN("Cannot write " << path);
+        return;
+    }
+    auto bssJson = [](const BssSpec& spec) {
+        std::ostringstream bss;
+        bss << "{\"standard\":" << JsonString(spec.standard) << ",\"sta_count\":" << spec.staCount
+            << ",\"data_mode\":" << JsonString(spec.dataMode)
+            << ",\"control_mode\":" << JsonString(spec.controlMode) << "}";
+        return bss.str();
+    };
+    auto histogramJson = [](const Log2Histogram& histogram) {
+        std::ostringstream json;
+        for (uint32_t bucket = 0; bucket < Log2Histogram::BUCKETS; ++bucket)
+        {
+            json << (bucket > 0 ? "," : "{") << JsonString(Log2Histogram::GetLabel(bucket)) << ":"
+                 << histogram.GetCount(bucket);
+        }
+        json << "}";
+        return json.str();
+    };
+    auto contentionJson = [&histogramJson](const ContentionStats::Histograms& h) {
+        std::ostringstream json;
+        json << "{\"ampdu_length\":" << histogramJson(h.ampduLength)
+             << ",\"mpdu_retries\":" << histogramJson(h.mpduRetries)
+             << ",\"backoff_slots\":" << histogramJson(h.backoffSlots) << ",\"ack_outcomes\":{";
+        for (uint32_t outcome = 0; outcome < ContentionStats::ACK_OUTCOMES; ++outcome)
+        {
+            json << (outcome > 0 ? "," : "") << JsonString(ContentionStats::GetAckOutcomeName(outcome)) << ":"
+                 << h.ackOutcomes[outcome];
+        }
+        json << "}}";
+        return json.str();
+    };
+    auto airtimeJson = [](const AirtimeBreakdown::Counters& a) {
+        std::ostringstream airtime;
+        airtime << std::setprecision(10) << "{\"data_s\":" << a.data << ",\"retry_s\":" << a.retry
+                << ",\"control_s\":" << a.control << ",\"management_s\":" << a.management
+                << ",\"unacknowledged_s\":" << a.unacknowledged << ",\"receive_s\":" << a.receive
+                << ",\"cca_busy_s\":" << a.ccaBusy << ",\"idle_s\":" << a.idle << ",\"ppdus\":" << a.ppdus
+                << "}";
+        return airtime.str();
+    };
+
+    out << std::setprecision(10) << std::boolalpha;
+    out << "{\"scenario\":" << JsonString(config.name)
+        << ",\"rng_seed\":" << RngSeedManager::GetSeed() << ",\"rng_run\":" << RngSeedManager::GetRun()
+        << ",\"config\":{\"legacy\":" << bssJson(config.legacy) << ",\"modern\":" << bssJson(config.modern)
+        << ",\"radius\":" << config.radius
+        << ",\"trace_level\":" << JsonString(TraceLevelName(config.traceLevel))
+        << ",\"channel_settings\":" << JsonString(config.channelSettings)
+        << ",\"be_max_ampdu\":" << config.beMaxAmpdu << ",\"simulation_time\":" << config.simulationTime
+        << ",\"scheduler\":" << JsonString(config.scheduler)
+        << ",\"stack\":" << JsonString(config.stack) << ",\"traffic\":" << JsonString(config.traffic)
+        << ",\"client_interval\":" << config.clientInterval
+        << ",\"backlog_threshold\":" << config.backlogThreshold << ",\"warmup\":" << config.warmup
+        << ",\"convergence\":" << config.convergence << ",\"convergence_batch\":" << config.convergenceBatch
+        << ",\"convergence_precision\":" << config.convergencePrecision
+        << ",\"convergence_min_batches\":" << config.convergenceMinBatches
+        << ",\"branch_time\":" << config.branchTime << ",\"branch_parameter\":" << JsonString(config.branchParameter)
+        << "},\"traffic_time\":" << trafficTime << ",\"measured_time\":" << measuredTime
+        << ",\"converged\":" << converged << ",\"profile\":{\"setup_s\":" << profile.setupSeconds
+        << ",\"run_s\":" << profile.runSeconds << ",\"events\":" << profile.events
+        << ",\"events_per_s\":" << profile.EventsPerSecond()
+        << ",\"simulated_s\":" << profile.simulatedSeconds
+        << ",\"sim_s_per_wall_s\":" << profile.SimulatedPerWallSecond()
+        << ",\"peak_rss_kb\":" << profile.peakRssKb << "},\"flows\":[";
+    for (uint32_t i = 0; i < results.size(); ++i)
+    {
+        const FlowResult& result = results[i];
+        const double loss = result.txPackets > 0 ? 100.0 * result.lostPackets / result.txPackets : 0.0;
+        out << (i > 0 ? "," : "") << "{\"label\":" << JsonString(result.label)
+            << ",\"bss\":" << JsonString(result.bss) << ",\"standard\":" << JsonString(result.standard)
+            << ",\"sta\":" << result.sta << ",\"throughput_mbps\":" << result.throughput
+            << ",\"delay_ms\":" << result.avgDelay * 1000 << ",\"jitter_ms\":" << result.avgJitter * 1000
+            << ",\"tx_packets\":" << result.txPackets << ",\"rx_packets\":" << result.rxPackets
+            << ",\"lost_packets\":" << result.lostPackets << ",\"loss_pct\":" << loss
+            << ",\"airtime_pct\":" << (trafficTime > 0.0 ? 100.0 * result.airtime.transmitTotal / trafficTime : 0.0)
+            << ",\"tx_airtime_measured_s\":" << result.airtime.Transmit() << ",\"tx_airtime_measured_pct\":"
+            << (measuredTime > 0.0 ? 100.0 * result.airtime.Transmit() / measuredTime : 0.0)
+            << ",\"airtime_breakdown\":" << airtimeJson(result.airtime)
+            << ",\"contention\":" << contentionJson(result.contention) << "}";
+    }
+    out << "],\"access_points\":[";
+    for (uint32_t i = 0; i < accessPoints.size(); ++i)
+    {
+        out << (i > 0 ? "," : "") << "{\"label\":" << JsonString(accessPoints[i].label)
+            << ",\"airtime_breakdown\":" << airtimeJson(accessPoints[i].airtime) << "}";
+    }
+    out << "]}" << std::endl;
+}
+
+// Results cross the worker pipe as text, one flow per line with the label last.
+std::string
+SerializeResults(const std::vector<FlowResult>& results)
+{
+    std::ostringstream out;
+    out << std::setprecision(17);
+    for (const FlowResult& result : results)
+    {
+        out << result.throughput << " " << result.avgDelay << " " << result.avgJitter << " "
+            << result.label << "\n";
+    }
+    return out.str();
+}
+
+std::vector<FlowResult>
+DeserializeResults(const std::string& text)
+{
+    std::vector<FlowResult> results;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::istringstream fields(line);
+        FlowResult result;
+        fields >> result.throughput >> result.avgDelay >> result.avgJitter;
+        std::getline(fields >> std::ws, result.label);
+        results.push_back(result);
+    }
+    return results;
+}
+
+/**
+ * Builds and runs one simulation. The per-flow results are printed (each line starting with
+ * @p linePrefix) and returned in @p results, in STA order.
+ */
+int
+RunScenario(ScenarioConfig config, std::vector<FlowResult>& results, const std::string& linePrefix = "")
+{
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point setupStart = Clock::now();
+    ObjectFactory scheduler;
+    if (config.eventProfile > 0)
+    {
+        scheduler.SetTypeId(EventSourceProfiler::GetTypeId());
+        scheduler.Set("Scheduler", TypeIdValue(ParseScheduler(config.scheduler)));
+    }
+    else
+    {
+        scheduler.SetTypeId(ParseScheduler(config.scheduler));
+    }
+    Simulator::SetScheduler(scheduler);
+    Config::SetDefault("ns3::WifiMac::BE_MaxAmpduSize", UintegerValue(config.beMaxAmpdu));
+
+    ns3::ShowProgress sp(Seconds(5));
+    AirtimeLogger airtimeLogger;
+
+    std::vector<Bss> bsses;
+    uint32_t staCount = 0;
+    for (const BssSpec* spec : {&config.legacy, &config.modern})
+    {
+        if (spec->staCount == 0)
+        {
+            continue;
+        }
+        Bss bss;
+        bss.spec = *spec;
+        auto [dataMode, controlMode] = DefaultModes(spec->standard);
+        if (bss.spec.dataMode.empty())
+        {
+            bss.spec.dataMode = dataMode;
+        }
+        if (bss.spec.controlMode.empty())
+        {
+            bss.spec.controlMode = controlMode;
+        }
+        bss.firstSta = staCount;
+        staCount += spec->staCount;
+        bsses.push_back(bss);
+    }
+    NS_ABORT_MSG_IF(bsses.empty(), "Scenario " << config.name << " has no STAs");
+
+    // Same-standard pairs (ax_2sta, be_2sta) keep the "network 1" / "network" naming.
+    const bool sameStandard = bsses.size() == 2 && bsses[0].spec.standard == bsses[1].spec.standard;
+    for (uint32_t b = 0; b < bsses.size(); ++b)
+    {
+        Bss& bss = bsses[b];
+        const bool legacySide = bsses.size() == 2 && b == 0;
+        const std::string prefix = bss.spec.staCount > 1 ? "staDevices" : "staDevice";
+        bss.label = "802.11" + bss.spec.standard;
+        if (config.deviceLabels == DeviceLabels::AB && legacySide)
+        {
+            bss.devices = {"staDeviceA"};
+        }
+        else if (config.deviceLabels == DeviceLabels::AB)
+        {
+            // The multi-STA AB programs tracked every STA under its own label.
+            for (uint32_t i = 0; i < bss.spec.staCount; ++i)
+            {
+                bss.devices.push_back(bss.spec.staCount > 1 ? "staDeviceB" + std::to_string(i + 1) : "staDeviceB");
+            }
+        }
+        else if (config.deviceLabels == DeviceLabels::PLAIN && bsses.size() == 1)
+        {
+            bss.devices = {prefix};
+        }
+        else
+        {
+            std::string suffix = bss.spec.standard;
+            suffix[0] = static_cast<char>(std::toupper(suffix[0]));
+            bss.devices = {prefix + (legacySide ? "Legacy" : suffix)};
+        }
+    }
+
+    NodeContainer wifiApNodes;
+    wifiApNodes.Create(bsses.size());
+    NodeContainer wifiStaNodes;
+    wifiStaNodes.Create(staCount);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    channel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+    channel.AddPropagationLoss("ns3::LogDistancePropagationLossModel",
+                               "Exponent", DoubleValue(1.0),
+                               "ReferenceLoss", DoubleValue(0.0));
+    Ptr<YansWifiChannel> sharedChannel = channel.Create();
+    if (config.channelCache)
+    {
+        // Nodes never move, so every transmission would recompute the same loss and delay per receiver.
+        PointerValue loss;
+        PointerValue delay;
+        sharedChannel->GetAttribute("PropagationLossModel", loss);
+        sharedChannel->GetAttribute("PropagationDelayModel", delay);
+        Ptr<CachedPropagationLossModel> cachedLoss = CreateObject<CachedPropagationLossModel>();
+        cachedLoss->SetModel(loss.Get<PropagationLossModel>());
+        Ptr<CachedPropagationDelayModel> cachedDelay = CreateObject<CachedPropagationDelayModel>();
+        cachedDelay->SetModel(delay.Get<PropagationDelayModel>());
+        sharedChannel->SetPropagationLossModel(cachedLoss);
+        sharedChannel->SetPropagationDelayModel(cachedDelay);
+    }
+
+    const std::string pcapBase = "scratch/pcap/" + config.name;
+    if (config.pcap)
+    {
+        std::error_code pcapEc;
+        std::filesystem::create_directories(pcapBase, pcapEc);
+        if (pcapEc)
+        {
+            NS_LOG_WARN("Failed to create pcap directory: " << pcapEc.message());
+        }
+    }
+
+    // Any limit switches from the full-fidelity helper capture to the bounded writer.
+    const BoundedPcapOptions& limits = config.pcapLimits;
+    const bool boundedPcap = limits.snapLen > 0 || limits.headerOnly || limits.start.IsStrictlyPositive() ||
+                             limits.stop.IsStrictlyPositive() || limits.maxFileBytes > 0;
+    BoundedPcapHelper pcapWriter(limits);
+
+    WifiMacHelper mac;
+    for (uint32_t b = 0; b < bsses.size(); ++b)
+    {
+        Bss& bss = bsses[b];
+
+        YansWifiPhyHelper phy;
+        phy.SetChannel(sharedChannel);
+        phy.Set("ChannelSettings", StringValue(config.channelSettings));
+        phy.SetPcapDataLinkType(YansWifiPhyHelper::DLT_IEEE802_11_RADIO);
+
+        WifiHelper wifi;
+        wifi.SetStandard(ParseStandard(bss.spec.standard));
+        wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                     "DataMode", StringValue(bss.spec.dataMode),
+                                     "ControlMode", StringValue(bss.spec.controlMode));
+
+        std::string ssidName = "network-80211" + bss.spec.standard;
+        if (sameStandard && b == 0)
+        {
+            ssidName += "-1";
+        }
+        Ssid ssid = Ssid(ssidName);
+
+        if (bss.spec.standard == "be" && config.legacyAssoc)
+        {
+            mac.SetType("ns3::StaWifiMac",
+                        "Ssid", SsidValue(ssid),
+                        "ActiveProbing", BooleanValue(true),
+                        "AssocType", EnumValue(WifiAssocType::LEGACY));
+        }
+        else
+        {
+            mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid), "ActiveProbing", BooleanValue(true));
+        }
+        for (uint32_t i = 0; i < bss.spec.staCount; ++i)
+        {
+            bss.staDevices.Add(wifi.Install(phy, mac, wifiStaNodes.Get(bss.firstSta + i)));
+        }
+        if (bss.devices.size() == 1)
+        {
+            airtimeLogger.TrackDevices(bss.staDevices, bss.devices[0]);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < bss.devices.size(); ++i)
+            {
+                airtimeLogger.TrackDevices(NetDeviceContainer(bss.staDevices.Get(i)), bss.devices[i]);
+            }
+        }
+
+        mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid), "EnableBeaconJitter", BooleanValue(false));
+        bss.apDevice = wifi.Install(phy, mac, wifiApNodes.Get(b));
+
+        if (config.pcap && boundedPcap)
+        {
+            pcapWriter.Enable(pcapBase + "/ap_" + ssidName.substr(8), bss.apDevice);
+            pcapWriter.Enable(pcapBase + "/sta_" + ssidName.substr(8), bss.staDevices);
+        }
+        else if (config.pcap)
+        {
+            phy.EnablePcap(pcapBase + "/ap_" + ssidName.substr(8), bss.apDevice, false);
+            phy.EnablePcap(pcapBase + "/sta_" + ssidName.substr(8), bss.staDevices, false);
+        }
+    }
+
+    const bool rawMac = config.stack == "raw";
+    if (rawMac)
+    {
+        // Only the senders need sockets; the APs count frames in a protocol handler.
+        PacketSocketHelper packetSocket;
+        packetSocket.Install(wifiStaNodes);
+    }
+    else
+    {
+        InternetStackHelper stack;
+        stack.Install(wifiApNodes);
+        stack.Install(wifiStaNodes);
+
+        Ipv4AddressHelper address;
+        uint16_t nextPort = 9000;
+        for (uint32_t b = 0; b < bsses.size(); ++b)
+        {
+            std::ostringstream base;
+            base << "10." << (b + 1) << ".1.0";
+            address.SetBase(base.str().c_str(), "255.255.255.0");
+            bsses[b].apInterface = address.Assign(bsses[b].apDevice);
+            address.Assign(bsses[b].staDevices);
+            bsses[b].firstPort = nextPort;
+            nextPort += bsses[b].spec.staCount;
+        }
+
+        if (config.arpCache)
+        {
+            PopulateArpCache();
+        }
+    }
+
+    // --- MOBILITY: AP-y w (0,0,0), STAs na okręgu o promieniu r wokół swojego AP
+    const double r = config.radius;
+    const double twoPi = 6.283185307179586;    // 2*pi
+    const double theta0 = 0.39269908169872414; // pi/8
+
+    std::vector<Vector> staPositions;
+    staPositions.reserve(staCount);
+    for (uint32_t b = 0; b < bsses.size(); ++b)
+    {
+        const uint32_t count = bsses[b].spec.staCount;
+        const bool legacySide = bsses.size() == 2 && b == 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (legacySide && count == 1)
+            {
+                staPositions.emplace_back(r, 0.0, 0.0);
+                continue;
+            }
+            double theta = theta0 + twoPi * static_cast<double>(i) / static_cast<double>(count);
+            staPositions.emplace_back(r * std::cos(theta), r * std::sin(theta), 0.0);
+        }
+    }
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    for (uint32_t b = 0; b < bsses.size(); ++b)
+    {
+        positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    }
+    for (const Vector& position : staPositions)
+    {
+        positionAlloc->Add(position);
+    }
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(wifiApNodes);
+    mobility.Install(wifiStaNodes);
+
+    // Positions are constant, so only the full trace keeps polling them.
+    std::unique_ptr<AnimationInterface> anim;
+    if (config.netAnim)
+    {
+        anim = std::make_unique<AnimationInterface>("scratch/netanim/" + config.name + ".xml");
+        switch (config.traceLevel)
+        {
+        case TraceLevel::FULL:
+            anim->EnablePacketMetadata(true);
+            anim->SetMobilityPollInterval(Seconds(0.25));
+            break;
+        case TraceLevel::SAMPLED:
+            anim->SetMobilityPollInterval(Seconds(config.simulationTime + 2.0));
+            anim->SetStartTime(Seconds(1.0 + config.warmup));
+            anim->SetStopTime(Seconds(1.0 + config.warmup + config.traceWindow));
+            break;
+        default:
+            anim->SetMobilityPollInterval(Seconds(config.simulationTime + 2.0));
+            anim->SkipPacketTracing();
+            break;
+        }
+
+        for (uint32_t b = 0; b < bsses.size(); ++b)
+        {
+            const Bss& bss = bsses[b];
+            Ptr<Node> apNode = wifiApNodes.Get(b);
+            anim->SetConstantPosition(apNode, 0.0, 0.0);
+            anim->UpdateNodeDescription(apNode->GetId(), "AP-" + bss.label);
+            auto [apRed, apGreen, apBlue] = ApColor(bss.spec.standard);
+            anim->UpdateNodeColor(apNode->GetId(), apRed, apGreen, apBlue);
+
+            for (uint32_t i = 0; i < bss.spec.staCount; ++i)
+            {
+                Ptr<Node> staNode = wifiStaNodes.Get(bss.firstSta + i);
+                const Vector& position = staPositions[bss.firstSta + i];
+                anim->SetConstantPosition(staNode, position.x, position.y);
+                std::ostringstream description;
+                description << "STA-" << bss.label;
+                if (bss.spec.staCount > 1)
+                {
+                    description << " #" << (i + 1);
+                }
+                anim->UpdateNodeDescription(staNode->GetId(), description.str());
+                auto [staRed, staGreen, staBlue] = StaColor(bss.spec.standard, i);
+                anim->UpdateNodeColor(staNode->GetId(), staRed, staGreen, staBlue);
+            }
+        }
+    }
+
+    const double simulationTime = config.simulationTime;
+    ApplicationContainer clientApps;
+    // Flows are added in STA order, so a flow's index is the flat STA index.
+    std::unique_ptr<MacFlowMonitor> macFlows;
+    if (rawMac)
+    {
+        macFlows = std::make_unique<MacFlowMonitor>();
+    }
+    for (uint32_t b = 0; b < bsses.size(); ++b)
+    {
+        const Bss& bss = bsses[b];
+        Ptr<Node> apNode = wifiApNodes.Get(b);
+        if (rawMac)
+        {
+            macFlows->TrackReceiver(bss.apDevice.Get(0));
+        }
+        for (uint32_t i = 0; i < bss.spec.staCount; ++i)
+        {
+            Ptr<NetDevice> staDevice = bss.staDevices.Get(i);
+            ApplicationContainer clientApp;
+            if (rawMac)
+            {
+                PacketSocketAddress remote;
+                remote.SetSingleDevice(staDevice->GetIfIndex());
+                remote.SetPhysicalAddress(bss.apDevice.Get(0)->GetAddress());
+                remote.SetProtocol(MacFlowMonitor::PROTOCOL);
+                // 1500-byte MSDUs, as the 1472-byte UDP payloads of the IP stack become.
+                if (config.traffic == "backlogged")
+                {
+                    BackloggedClientHelper backlogged(remote);
+                    backlogged.SetAttribute("Threshold", UintegerValue(config.backlogThreshold));
+                    backlogged.SetAttribute("PacketSize", UintegerValue(1500));
+                    clientApp = backlogged.Install(staDevice->GetNode());
+                }
+                else
+                {
+                    Ptr<PacketSocketClient> client = CreateObject<PacketSocketClient>();
+                    client->SetRemote(remote);
+                    client->SetAttribute("MaxPackets", UintegerValue(0)); // unlimited
+                    client->SetAttribute("Interval", TimeValue(Seconds(config.clientInterval)));
+                    client->SetAttribute("PacketSize", UintegerValue(1500));
+                    staDevice->GetNode()->AddApplication(client);
+                    clientApp.Add(client);
+                }
+                macFlows->AddFlow(staDevice, clientApp.Get(0));
+            }
+            else
+            {
+                const uint16_t port = bss.firstPort + i;
+
+                UdpServerHelper udpServer(port);
+                ApplicationContainer serverApp = udpServer.Install(apNode);
+                serverApp.Start(Seconds(0.0));
+                serverApp.Stop(Seconds(simulationTime + 1.0));
+
+                if (config.traffic == "backlogged")
+                {
+                    BackloggedClientHelper backlogged(bss.apInterface.GetAddress(0), port);
+                    backlogged.SetAttribute("Threshold", UintegerValue(config.backlogThreshold));
+                    backlogged.SetAttribute("PacketSize", UintegerValue(1472));
+                    clientApp = backlogged.Install(wifiStaNodes.Get(bss.firstSta + i));
+                }
+                else
+                {
+                    UdpClientHelper udpClient(bss.apInterface.GetAddress(0), port);
+                    udpClient.SetAttribute("MaxPackets", UintegerValue(4294967295u));
+                    udpClient.SetAttribute("Interval", TimeValue(Seconds(config.clientInterval)));
+                    udpClient.SetAttribute("PacketSize", UintegerValue(1472));
+                    clientApp = udpClient.Install(wifiStaNodes.Get(bss.firstSta + i));
+                }
+            }
+            clientApp.Start(Seconds(1.0));
+            clientApp.Stop(Seconds(simulationTime + 1.0));
+            clientApps.Add(clientApp);
+        }
+    }
+
+    FlowMonitorHelper flowmon;
+    Ptr<FlowMonitor> monitor;
+    if (!rawMac)
+    {
+        monitor = flowmon.InstallAll();
+    }
+
+    // Association, ARP and the initial queue build-up fall into the warm-up and are not measured.
+    const double trafficStart = 1.0;
+    const double measurementStart = trafficStart + config.warmup;
+    if (config.warmup > 0.0 && monitor)
+    {
+        Simulator::Schedule(Seconds(measurementStart), &FlowMonitor::ResetAllStats, monitor);
+    }
+    else if (config.warmup > 0.0)
+    {
+        Simulator::Schedule(Seconds(measurementStart), &MacFlowMonitor::ResetAllStats, macFlows.get());
+    }
+
+    std::unique_ptr<ConvergenceMonitor> convergence;
+    if (config.convergence)
+    {
+        convergence = std::make_unique<ConvergenceMonitor>(monitor,
+                                                           Seconds(config.convergenceBatch),
+                                                           config.convergencePrecision,
+                                                           config.convergenceMinBatches);
+        convergence->Start(Seconds(measurementStart));
+    }
+
+    std::unique_ptr<FlowTimeSeriesSampler> sampler;
+    if (config.sampleInterval > 0.0)
+    {
+        sampler = std::make_unique<FlowTimeSeriesSampler>(monitor,
+                                                          Seconds(config.sampleInterval / 1000.0),
+                                                          Seconds(simulationTime + 0.5),
+                                                          staCount);
+        sampler->Start(Seconds(trafficStart));
+    }
+
+    // STAs are tracked first, so a STA's airtime index is its flat index; the APs follow.
+    AirtimeBreakdown airtimeBreakdown(Seconds(measurementStart));
+    for (const Bss& bss : bsses)
+    {
+        for (uint32_t i = 0; i < bss.spec.staCount; ++i)
+        {
+            airtimeBreakdown.Track(bss.staDevices.Get(i));
+        }
+    }
+    for (const Bss& bss : bsses)
+    {
+        airtimeBreakdown.Track(bss.apDevice.Get(0));
+    }
+    ContentionStats contention(Seconds(measurementStart));
+    for (const Bss& bss : bsses)
+    {
+        for (uint32_t i = 0; i < bss.spec.staCount; ++i)
+        {
+            contention.Track(bss.staDevices.Get(i));
+        }
+    }
+
+    // Fork-after-warm-up: everything up to branchTime runs once, each child continues with one value.
+    bool branchParent = false;
+    uint32_t failedBranches = 0;
+    if (!config.branchValues.empty())
+    {
+        Simulator::Schedule(Seconds(config.branchTime), [&]() {
+            std::vector<std::string> labels;
+            for (const std::string& value : config.branchValues)
+            {
+                labels.push_back(config.name + "_" + config.branchParameter + "_" + value);
+            }
+            const int branch = ForkBranches(labels, config.branchParallel, failedBranches);
+            if (branch < 0)
+            {
+                branchParent = true;
+                Simulator::Stop();
+                return;
+            }
+            config.name = labels[branch];
+            RedirectBranchOutput(config.name);
+            ApplyBranchValue(config, config.branchValues[branch], clientApps);
+            std::cout << "Branched at " << config.branchTime << " s with " << config.branchParameter
+                      << "=" << config.branchValues[branch] << std::endl;
+        });
+    }
+
+    Simulator::Stop(Seconds(simulationTime + 1.5));
+    const Clock::time_point runStart = Clock::now();
+    Simulator::Run();
+    RunProfile profile;
+    profile.setupSeconds = std::chrono::duration<double>(runStart - setupStart).count();
+    profile.runSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+    profile.events = Simulator::GetEventCount();
+    profile.simulatedSeconds = Simulator::Now().GetSeconds();
+    profile.peakRssKb = PeakRssKb();
+
+    if (branchParent)
+    {
+        Simulator::Destroy();
+        return failedBranches == 0 ? 0 : 1;
+    }
+
+    // An early stop shortens the traffic time; flow statistics only cover the part after the warm-up.
+    double trafficTime = simulationTime;
+    if (convergence && convergence->HasConverged())
+    {
+        trafficTime = convergence->GetConvergenceTime().GetSeconds() - trafficStart;
+    }
+    const double measuredTime = trafficTime - config.warmup;
+    if (convergence && convergence->HasConverged())
+    {
+        std::cout << "Converged after " << measuredTime << " s of measurement ("
+                  << convergence->GetBatchCount() << " batches, worst relative CI half-width "
+                  << convergence->GetWorstPrecision() << ")" << std::endl;
+    }
+
+    // FlowMonitor::FlowStats and MacFlowMonitor::FlowStats have the same counters.
+    auto fillResult = [measuredTime](FlowResult& result, const auto& flow) {
+        const uint32_t rx = flow.rxPackets;
+        result.txPackets = flow.txPackets;
+        result.rxPackets = rx;
+        result.lostPackets = flow.lostPackets;
+        if (rx > 0)
+        {
+            result.throughput = (flow.rxBytes * 8.0) / (measuredTime * 1e6);
+            result.avgDelay = flow.delaySum.GetSeconds() / rx;
+            if (rx > 1)
+            {
+                result.avgJitter = flow.jitterSum.GetSeconds() / (rx - 1);
+            }
+        }
+    };
+
+    results.assign(staCount, FlowResult());
+    Ptr<Ipv4FlowClassifier> classifier;
+    if (monitor)
+    {
+        monitor->CheckForLostPackets();
+        classifier = DynamicCast<Ipv4FlowClassifier>(flowmon.GetClassifier());
+        // Ports are assigned consecutively from 9000, so the port offset is the flat STA index.
+        for (const auto& flow : monitor->GetFlowStats())
+        {
+            Ipv4FlowClassifier::FiveTuple t = classifier->FindFlow(flow.first);
+            if (t.destinationPort < 9000 || t.destinationPort >= 9000 + staCount)
+            {
+                continue;
+            }
+            fillResult(results[t.destinationPort - 9000], flow.second);
+        }
+    }
+    else
+    {
+        macFlows->CheckForLostPackets();
+        for (uint32_t i = 0; i < staCount; ++i)
+        {
+            fillResult(results[i], macFlows->Get(i));
+        }
+    }
+
+    std::cout << linePrefix << "Results after " << measuredTime << " seconds of simulation";
+    if (config.warmup > 0.0)
+    {
+        std::cout << " (excluding " << config.warmup << " s warm-up)";
+    }
+    std::cout << ":" << std::endl;
+    for (uint32_t b = 0; b < bsses.size(); ++b)
+    {
+        const Bss& bss = bsses[b];
+        for (uint32_t i = 0; i < bss.spec.staCount; ++i)
+        {
+            FlowResult& result = results[bss.firstSta + i];
+            result.bss = (bsses.size() == 2 && b == 0) ? "legacy" : "modern";
+            result.standard = bss.spec.standard;
+            result.sta = i + 1;
+            result.airtime = airtimeBreakdown.Get(bss.firstSta + i);
+            result.contention = contention.Get(bss.firstSta + i);
+            result.label = bss.label;
+            if (bss.spec.staCount > 1)
+            {
+                result.label += " STA #" + std::to_string(i + 1);
+            }
+            else
+            {
+                result.label += (sameStandard && b == 0) ? " network 1" : " network";
+            }
+            std::cout << linePrefix << result.label << " - Throughput: " << result.throughput << " Mbit/s"
+                      << ", Average delay: " << (result.avgDelay * 1000) << " ms"
+                      << ", Average jitter: " << (result.avgJitter * 1000) << " ms" << std::endl;
+        }
+    }
+
+    std::vector<DeviceAirtime> accessPoints;
+    for (uint32_t b = 0; b < bsses.size(); ++b)
+    {
+        const std::string suffix = (sameStandard && b == 0) ? " 1" : "";
+        accessPoints.push_back({"AP " + bsses[b].label + suffix, airtimeBreakdown.Get(staCount + b)});
+    }
+
+    // AirtimeLogger cannot be reset, so its shares stay relative to the whole traffic time.
+    airtimeLogger.PrintSummary(trafficTime);
+    PrintAirtimeBreakdown(linePrefix, results, accessPoints);
+    PrintContention(linePrefix, results);
+    std::cout << linePrefix << "Profile (" << config.scheduler << " scheduler): setup " << profile.setupSeconds
+              << " s, run " << profile.runSeconds << " s, " << profile.events << " events (" << profile.EventsPerSecond() << " events/s), "
+              << profile.SimulatedPerWallSecond() << " simulated s per wall s, peak RSS "
+              << profile.peakRssKb / 1024 << " MB" << std::endl;
+    if (config.eventProfile > 0)
+    {
+        EventSourceProfiler::GetActive()->Print(std::cout, linePrefix, config.eventProfile);
+    }
+    WriteResultsRecord(config,
+                       results,
+                       accessPoints,
+                       profile,
+                       trafficTime,
+                       measuredTime,
+                       convergence && convergence->HasConverged());
+    if (sampler)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories("scratch/timeseries", ec);
+        sampler->Dump("scratch/timeseries/" + config.name + ".fts");
+    }
+    // With stack=raw the results record holds everything MacFlowMonitor counts.
+    if (monitor && config.traceLevel != TraceLevel::NONE)
+    {
+        std::error_code ec;
+        std::filesystem::create_directories("scratch/flowmon", ec);
+    }
+    if (monitor && config.traceLevel != TraceLevel::NONE && !config.flowmonXml)
+    {
+        WriteFlowStatsBinary("scratch/flowmon/" + config.name + ".fmb", monitor, classifier);
+    }
+    else if (monitor && config.traceLevel != TraceLevel::NONE)
+    {
+        monitor->SerializeToXmlFile("scratch/flowmon/" + config.name + ".flowmon",
+                                    config.traceLevel >= TraceLevel::SAMPLED,
+                                    config.traceLevel == TraceLevel::FULL);
+    }
+    anim.reset();
+    Simulator::Destroy();
+    return 0;
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    ScenarioConfig config;
+    config.name = FindScenarioArgument(argc, argv, "scenario_coex_a_ax");
+    config.channelSettings = "{36, 20, BAND_5GHZ, 0}";
+    config.channelCache = true;
+    config.beMaxAmpdu = 0;
+    config.simulationTime = 260.0;  // seconds
+    config.stack = "ip";
+    config.traffic = "udp";
+    config.clientInterval = 0.0001; // seconds
+    config.backlogThreshold = 0;
+    config.warmup = 0.0;
+    config.convergence = false;
+    config.convergenceBatch = 1.0;
+    config.convergencePrecision = 0.01;
+    config.convergenceMinBatches = 10;
+    config.branchTime = 0.0;
+    config.branchParallel = std::thread::hardware_concurrency();
+    config.replications = 1;
+    config.parallel = 1;
+    std::string branchValues;
+    std::string traceLevel = "full";
+    config.traceWindow = 1.0;
+    std::string flowmonFormat = "binary";
+    config.sampleInterval = 0.0;
+    config.eventProfile = 0;
+    config.scheduler = "map";
+    double pcapStart = 0.0;
+    double pcapDuration = 0.0;
+    double pcapMaxFileMb = 0.0;
+    ApplyPreset(*FindPreset("scenario_coex_a_ax"), config);
+    if (const ScenarioPreset* preset = FindPreset(config.name))
+    {
+        ApplyPreset(*preset, config);
+    }
+
+    CommandLine cmd;
+    cmd.AddValue("scenario", "Preset name (e.g. scenario_coex_a_ax_decsta); also names the output files", config.name);
+    cmd.AddValue("legacyStandard", "Standard of the legacy BSS (a, n, ac, ax, be)", config.legacy.standard);
+    cmd.AddValue("legacyStaCount", "Number of STAs in the legacy BSS (0 disables it)", config.legacy.staCount);
+    cmd.AddValue("legacyDataMode", "Legacy data mode (empty: default for the standard)", config.legacy.dataMode);
+    cmd.AddValue("legacyControlMode", "Legacy control mode (empty: default for the standard)", config.legacy.controlMode);
+    cmd.AddValue("modernStandard", "Standard of the modern BSS (a, n, ac, ax, be)", config.modern.standard);
+    cmd.AddValue("modernStaCount", "Number of STAs in the modern BSS", config.modern.staCount);
+    cmd.AddValue("modernDataMode", "Modern data mode (empty: default for the standard)", config.modern.dataMode);
+    cmd.AddValue("modernControlMode", "Modern control mode (empty: default for the standard)", config.modern.controlMode);
+    cmd.AddValue("channelSettings", "PHY ChannelSettings shared by both BSSs", config.channelSettings);
+    cmd.AddValue("channelCache", "Compute the loss and delay of every static node pair once instead of per transmission", config.channelCache);
+    cmd.AddValue("radius", "Distance between each STA and its AP (m)", config.radius);
+    cmd.AddValue("netAnim", "Write a NetAnim trace to scratch/netanim", config.netAnim);
+    cmd.AddValue("pcap", "Write radiotap pcap files to scratch/pcap", config.pcap);
+    cmd.AddValue("legacyAssoc", "Associate 802.11be STAs with AssocType=LEGACY", config.legacyAssoc);
+    cmd.AddValue("arpCache", "Fill the ARP caches before the traffic starts (stack=ip)", config.arpCache);
+    cmd.AddValue("pcapSnapLen", "Bytes kept per captured frame, radiotap header included (0: whole frame)", config.pcapLimits.snapLen);
+    cmd.AddValue("pcapHeaderOnly", "Capture only the radiotap and MAC headers", config.pcapLimits.headerOnly);
+    cmd.AddValue("pcapStart", "Start of the pcap capture (s)", pcapStart);
+    cmd.AddValue("pcapDuration", "Length of the pcap capture (s, 0: until the end)", pcapDuration);
+    cmd.AddValue("pcapMaxFileSize", "Start a new pcap file once this size is reached (MB, 0: one file)", pcapMaxFileMb);
+    cmd.AddValue("pcapMaxFiles", "Keep only the newest rotated pcap files of every device (0: keep all)", config.pcapLimits.maxFiles);
+    cmd.AddValue("flowmonFormat", "FlowMonitor export: binary (.fmb, per-flow stats only) or xml (.flowmon with histograms/probes per traceLevel)", flowmonFormat);
+    cmd.AddValue("sampleInterval", "Per-flow time-series sampling period written to scratch/timeseries (ms, 0 disables)", config.sampleInterval);
+    cmd.AddValue("scheduler", "Simulator event queue: map, heap, calendar or list", config.scheduler);
+    cmd.AddValue("eventProfile", "Attribute events and handler wall time to their source and print the top N sources (0 disables)", config.eventProfile);
+    cmd.AddValue("traceLevel", "Per-packet tracing: none, summary, sampled or full (caps netAnim and pcap)", traceLevel);
+    cmd.AddValue("traceWindow", "Length of the NetAnim/pcap window at traceLevel=sampled, from the end of the warm-up (s)", config.traceWindow);
+    cmd.AddValue("beMaxAmpdu", "Maximum A-MPDU size for BE traffic (bytes, 0 disables aggregation)", config.beMaxAmpdu);
+    cmd.AddValue("simulationTime", "Total simulation time (s)", config.simulationTime);
+    cmd.AddValue("stack", "ip (IPv4/UDP, FlowMonitor) or raw (packet sockets on the Wi-Fi device, no IP/UDP/ARP)", config.stack);
+    cmd.AddValue("traffic", "Uplink source: udp (UdpClient every clientInterval) or backlogged (keeps the STA's BE queue full)", config.traffic);
+    cmd.AddValue("clientInterval", "UDP client packet interval (s); also the PacketSocketClient interval with stack=raw", config.clientInterval);
+    cmd.AddValue("backlogThreshold", "Backlogged traffic: refill the BE queue once it holds fewer MPDUs (0: whenever it is not full)", config.backlogThreshold);
+    cmd.AddValue("warmup", "Traffic time excluded from the flow statistics (s); the rest of simulationTime is measured", config.warmup);
+    cmd.AddValue("convergence", "Stop once throughput and delay CIs converge (simulationTime stays the upper bound)", config.convergence);
+    cmd.AddValue("convergenceBatch", "Batch length for the batch-means CIs (s)", config.convergenceBatch);
+    cmd.AddValue("convergencePrecision", "Target relative 95% CI half-width of every flow", config.convergencePrecision);
+    cmd.AddValue("convergenceMinBatches", "Minimum number of batches before stopping", config.convergenceMinBatches);
+    cmd.AddValue("branchTime", "Simulation time at which the run forks into branches (s)", config.branchTime);
+    cmd.AddValue("branchParameter", "Parameter changed in each branch (clientInterval or beMaxAmpdu)", config.branchParameter);
+    cmd.AddValue("branchValues", "Comma-separated values of branchParameter, one branch each (empty: no branching)", branchValues);
+    cmd.AddValue("branchParallel", "Maximum number of branches running at once", config.branchParallel);
+    cmd.AddValue("replications", "Number of independent runs (RngRun, RngRun + 1, ...) summarised by mean, stddev and CI", config.replications);
+    cmd.AddValue("parallel", "Worker processes sharing the replications", config.parallel);
+    cmd.Parse(argc, argv);
+
+    config.traceLevel = ParseTraceLevel(traceLevel);
+    ParseScheduler(config.scheduler); // abort on a bad name before any run starts
+    NS_ABORT_MSG_IF(flowmonFormat != "binary" && flowmonFormat != "xml", "flowmonFormat must be binary or xml");
+    config.flowmonXml = flowmonFormat == "xml";
+    if (config.traceLevel == TraceLevel::NONE)
+    {
+        config.netAnim = false;
+    }
+    if (config.traceLevel <= TraceLevel::SUMMARY)
+    {
+        config.pcap = false;
+    }
+
+    NS_ABORT_MSG_IF(config.traffic != "udp" && config.traffic != "backlogged", "traffic must be udp or backlogged");
+    NS_ABORT_MSG_IF(config.stack != "ip" && config.stack != "raw", "stack must be ip or raw");
+    // MilliSeconds() would truncate the fractional milliseconds, down to an interval of zero.
+    NS_ABORT_MSG_IF(config.sampleInterval < 0.0 ||
+                        (config.sampleInterval > 0.0 && Seconds(config.sampleInterval / 1000.0).IsZero()),
+                    "sampleInterval must be 0 or a positive time (ms)");
+    NS_ABORT_MSG_IF(config.stack == "raw" && (config.convergence || config.sampleInterval > 0.0),
+                    "convergence and sampleInterval read FlowMonitor and need stack=ip");
+
+    config.branchValues = SplitList(branchValues);
+    if (!config.branchValues.empty())
+    {
+        NS_ABORT_MSG_IF(config.branchParameter != "clientInterval" && config.branchParameter != "beMaxAmpdu",
+                        "branchParameter must be clientInterval or beMaxAmpdu");
+        NS_ABORT_MSG_IF(config.branchParameter == "clientInterval" && config.traffic != "udp",
+                        "branchParameter=clientInterval needs traffic=udp");
+        NS_ABORT_MSG_IF(config.branchTime < 1.0 || config.branchTime >= config.simulationTime + 1.0,
+                        "branchTime must be within the traffic period [1, simulationTime + 1)");
+        // Branches share the prefix, so they are only measured from the branch point on; NetAnim
+        // and pcap files opened before the fork cannot be shared by the children.
+        config.warmup = std::max(config.warmup, config.branchTime - 1.0);
+        config.netAnim = false;
+        config.pcap = false;
+    }
+
+    NS_ABORT_MSG_IF(config.warmup < 0.0 || config.warmup >= config.simulationTime,
+                    "warmup must be in [0, simulationTime)");
+
+    if (config.traceLevel == TraceLevel::SAMPLED && pcapStart == 0.0 && pcapDuration == 0.0)
+    {
+        pcapStart = 1.0 + config.warmup;
+        pcapDuration = config.traceWindow;
+    }
+    NS_ABORT_MSG_IF(pcapStart < 0.0 || pcapDuration < 0.0 || pcapMaxFileMb < 0.0,
+                    "pcapStart, pcapDuration and pcapMaxFileSize must not be negative");
+    config.pcapLimits.start = Seconds(pcapStart);
+    config.pcapLimits.stop = pcapDuration > 0.0 ? Seconds(pcapStart + pcapDuration) : Time();
+    config.pcapLimits.maxFileBytes = static_cast<uint64_t>(pcapMaxFileMb * 1e6);
+
+    std::vector<FlowResult> results;
+    if (config.replications <= 1)
+    {
+        return RunScenario(config, results);
+    }
+
+    // Replication r uses RngRun base + r and writes its traces under <scenario>_run<r>.
+    NS_ABORT_MSG_IF(!config.branchValues.empty(), "replications cannot be combined with branchValues");
+    const uint64_t baseRun = RngSeedManager::GetRun();
+    auto runReplication = [&](uint32_t r) {
+        ScenarioConfig replication = config;
+        replication.name = config.name + "_run" + std::to_string(r + 1);
+        RngSeedManager::SetRun(baseRun + r);
+        std::vector<FlowResult> replicationResults;
+        std::ostringstream prefix;
+        prefix << "Replication " << (r + 1) << ": ";
+        NS_ABORT_MSG_IF(RunScenario(replication, replicationResults, prefix.str()) != 0,
+                        "Replication " << (r + 1) << " failed");
+        return replicationResults;
+    };
+
+    std::vector<std::vector<FlowResult>> runs;
+    if (config.parallel <= 1)
+    {
+        for (uint32_t r = 0; r < config.replications; ++r)
+        {
+            runs.push_back(runReplication(r));
+        }
+    }
+    else
+    {
+        for (const std::string& text :
+             RunInWorkers(config.replications, config.parallel, [&](uint32_t r) {
+                 return SerializeResults(runReplication(r));
+             }))
+        {
+            runs.push_back(DeserializeResults(text));
+        }
+    }
+
+    std::cout << "Mean over " << config.replications << " replications (RngRun " << baseRun << " to "
+              << (baseRun + config.replications - 1) << "):" << std::endl;
+    for (uint32_t f = 0; f < runs.front().size(); ++f)
+    {
+        std::vector<double> throughput;
+        std::vector<double> delay;
+        std::vector<double> jitter;
+        for (const auto& run : runs)
+        {
+            NS_ABORT_MSG_IF(run.size() != runs.front().size(), "Replications report different flows");
+            throughput.push_back(run[f].throughput);
+            delay.push_back(run[f].avgDelay * 1000);
+            jitter.push_back(run[f].avgJitter * 1000);
+        }
+        const SampleSummary t = Summarize(throughput);
+        const SampleSummary d = Summarize(delay);
+        const SampleSummary j = Summarize(jitter);
+        std::cout << runs.front()[f].label << " - Throughput: " << t.mean << " Mbit/s"
+                  << ", Average delay: " << d.mean << " ms"
+                  << ", Average jitter: " << j.mean << " ms" << std::endl;
+        std::cout << "    stddev " << t.stddev << " Mbit/s, " << d.stddev << " ms, " << j.stddev
+                  << " ms; 95% CI +/- " << t.ciHalfWidth << " Mbit/s, " << d.ciHalfWidth << " ms, "
+                  << j.ciHalfWidth << " ms" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,307 @@
+#!/usr/bin/env python3
+
+"""Manifest-driven executor for scenario_coex sweeps.
+
+A coordinator writes the jobs of a sweep into a manifest directory; any number of workers, on
+this machine or on every node that mounts the directory, claim them and run scenario_coex. No
+service is involved: the state of a job is the directory its file is in.
+
+    <manifest>/manifest.json           settings (timeout, attempts, log directory)
+    <manifest>/queue/NNNNNN.<job>.json  waiting jobs, claimed in NNNNNN order
+    <manifest>/running/...@<worker>     claimed jobs; the worker touches the file while it runs
+    <manifest>/done/<job>.json          finished jobs with their run time
+    <manifest>/failed/<job>.json        jobs that failed on every attempt
+
+A job is claimed by renaming it from queue/ to running/, which is atomic on a POSIX file
+system (NFS included), so exactly one worker gets it. A job that fails or exceeds --timeout
+goes back to the queue until it has used --attempts attempts; a job whose worker stopped
+touching its claim for --lease seconds (crashed worker, lost node) is re-queued by any other
+worker. Results are whatever scenario_coex writes under the project root.
+
+    python3 sweep_executor.py submit --manifest scratch/sweeps/all --scenario scenario_coex_a_ax ... --args="--simulationTime=60"
+    python3 sweep_executor.py submit --manifest scratch/sweeps/ampdu --jobs scratch/sweeps/ampdu/batch_001.jsonl
+    python3 sweep_executor.py work --manifest scratch/sweeps/all -j 16   # on every node
+    python3 sweep_executor.py status --manifest scratch/sweeps/all
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import os
+import shlex
+import signal
+import socket
+import subprocess
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+from typing import Optional
+
+STATES = ["queue", "running", "done", "failed"]
+OUTPUT_LOCK = threading.Lock()
+
+
+def report(line: str) -> None:
+    """Print one line from a worker thread without interleaving with the others."""
+    with OUTPUT_LOCK:
+        print(line, flush=True)
+
+
+class Manifest:
+    def __init__(self, root: Path):
+        self.root = root
+        self.settings = json.loads((root / "manifest.json").read_text(encoding="utf-8"))
+        self.log_dir = Path(self.settings["log_dir"])
+
+    def path(self, state: str) -> Path:
+        return self.root / state
+
+    def write_job(self, state: str, file_name: str, job: dict) -> None:
+        """Write through a temporary name so nobody claims or reads a half-written file."""
+        temporary = self.root / f".{file_name}.{os.getpid()}.tmp"
+        temporary.write_text(json.dumps(job) + "\n", encoding="utf-8")
+        os.replace(temporary, self.path(state) / file_name)
+
+    def claim(self, worker: str) -> Optional[tuple[Path, dict]]:
+        for queued in sorted(self.path("queue").glob("*.json")):
+            claimed = self.path("running") / f"{queued.name}@{worker}"
+            try:
+                # rename keeps the mtime, and an old one would make the fresh claim look stale
+                # to requeue_stale, so refresh it before the file shows up in running/
+                os.utime(queued)
+                os.rename(queued, claimed)
+                return claimed, json.loads(claimed.read_text(encoding="utf-8"))
+            except FileNotFoundError:
+                continue  # another worker was faster, or took the claim back
+        return None
+
+    def finish(self, claimed: Path, job: dict, state: str, queue_name: str) -> bool:
+        """Move a claimed job on; False if its lease had expired and it was taken away."""
+        file_name = queue_name if state == "queue" else f"{job['name']}.json"
+        temporary = self.root / f".{claimed.name}.tmp"
+        try:
+            os.rename(claimed, temporary)
+        except FileNotFoundError:
+            return False
+        temporary.write_text(json.dumps(job) + "\n", encoding="utf-8")
+        os.replace(temporary, self.path(state) / file_name)
+        return True
+
+    def requeue_stale(self, lease: float) -> int:
+        """Put jobs back whose worker has not touched the claim for @p lease seconds."""
+        requeued = 0
+        now = time.time()
+        for claimed in self.path("running").iterdir():
+            try:
+                if now - claimed.stat().st_mtime < lease:
+                    continue
+                job = json.loads(claimed.read_text(encoding="utf-8"))
+            except (FileNotFoundError, ValueError):
+                continue
+            queue_name, _, worker = claimed.name.partition("@")
+            job.setdefault("history", []).append({"worker": worker, "result": "lease expired"})
+            state = "queue" if len(job["history"]) < self.settings["attempts"] else "failed"
+            if self.finish(claimed, job, state, queue_name):
+                report(f"  [stale]  {job['name']} (claimed by {worker}) -> {state}")
+                requeued += 1
+        return requeued
+
+    def counts(self) -> dict[str, int]:
+        return {state: sum(1 for entry in self.path(state).iterdir() if not entry.name.startswith(".")) for state in STATES}
+
+
+def submit(args: argparse.Namespace) -> None:
+    root = args.manifest.resolve()
+    project_root = args.project_root.resolve()
+    jobs = []
+    for jobs_file in args.jobs or []:
+        lines = sys.stdin.read().splitlines() if str(jobs_file) == "-" else jobs_file.read_text(encoding="utf-8").splitlines()
+        jobs += [json.loads(line) for line in lines if line.strip()]
+    base_args = shlex.split(args.args)
+    jobs += [{"name": name, "args": [f"--scenario={name}", *base_args]} for name in args.scenario or []]
+    if not jobs:
+        raise SystemExit("Nothing to submit: give --jobs and/or --scenario")
+
+    if (root / "manifest.json").exists() and args.fresh:
+        for state in STATES:
+            for entry in (root / state).glob("*"):
+                entry.unlink()
+    for state in STATES:
+        (root / state).mkdir(parents=True, exist_ok=True)
+    if not (root / "manifest.json").exists() or args.fresh:
+        settings = {
+            "project_root": str(project_root),
+            "log_dir": str((args.log_dir or root / "logs").resolve()),
+            "timeout": args.timeout,
+            "attempts": args.attempts,
+            "created": time.strftime("%Y-%m-%dT%H:%M:%S"),
+        }
+        (root / "manifest.json").write_text(json.dumps(settings, indent=2) + "\n", encoding="utf-8")
+
+    manifest = Manifest(root)
+    known = set()
+    for state in STATES:
+        for entry in manifest.path(state).iterdir():
+            if not entry.name.startswith("."):
+                known.add(json.loads(entry.read_text(encoding="utf-8"))["name"])
+    sequence = sum(manifest.counts().values())
+    added = 0
+    for job in jobs:
+        if job["name"] in known:
+            continue  # resubmitting a batch only adds what is new
+        known.add(job["name"])
+        manifest.write_job("queue", f"{sequence:06d}.{job['name']}.json", {"name": job["name"], "args": job["args"]})
+        sequence += 1
+        added += 1
+    print(f"Queued {added} jobs in {root} ({len(jobs) - added} already known)")
+
+
+def run_job(manifest: Manifest, claimed: Path, job: dict, worker: str, lease: float) -> None:
+    queue_name = claimed.name.partition("@")[0]
+    project_root = Path(manifest.settings["project_root"])
+    timeout = manifest.settings["timeout"] or None
+    manifest.log_dir.mkdir(parents=True, exist_ok=True)
+    log_path = manifest.log_dir / f"{job['name']}.log"
+    command = [str(project_root / "ns3"), "run", "--no-build", "scenario_coex", "--", *job["args"]]
+
+    # Touch the claim while the job runs, so other workers see this one is alive.
+    stopped = threading.Event()
+
+    def heartbeat() -> None:
+        while not stopped.wait(lease / 4):
+            try:
+                os.utime(claimed)
+            except FileNotFoundError:
+                return
+
+    threading.Thread(target=heartbeat, daemon=True).start()
+    started = time.monotonic()
+    with log_path.open("w", encoding="utf-8") as log:
+        # A session of its own, so a timeout kills the ns3 wrapper and the simulation together.
+        process = subprocess.Popen(command, cwd=project_root, stdout=log, stderr=subprocess.STDOUT, start_new_session=True)
+        try:
+            returncode = process.wait(timeout=timeout)
+            result = "ok" if returncode == 0 else f"exit {returncode}"
+        except subprocess.TimeoutExpired:
+            os.killpg(process.pid, signal.SIGKILL)
+            process.wait()
+            result = f"timeout after {timeout:g} s"
+    stopped.set()
+    seconds = round(time.monotonic() - started, 3)
+
+    job.setdefault("history", []).append({"worker": worker, "result": result, "seconds": seconds})
+    if result == "ok":
+        job.update(seconds=seconds, worker=worker, log=str(log_path))
+        state = "done"
+    else:
+        state = "queue" if len(job["history"]) < manifest.settings["attempts"] else "failed"
+    if not manifest.finish(claimed, job, state, queue_name):
+        report(f"  [lost]   {job['name']} (lease expired while running, result ignored)")
+        return
+    label = {"done": "ok", "queue": "retry", "failed": "FAILED"}[state]
+    report(f"  [{label}]{' ' * (7 - len(label))}{job['name']} ({result}, {seconds:g} s, log: {log_path})")
+
+
+def work(args: argparse.Namespace) -> None:
+    manifest = Manifest(args.manifest.resolve())
+    worker_base = args.worker_id or f"{socket.gethostname()}-{os.getpid()}"
+
+    def loop(slot: int) -> int:
+        worker = f"{worker_base}-{slot}"
+        finished = 0
+        while True:
+            claim = manifest.claim(worker)
+            if claim:
+                run_job(manifest, claim[0], claim[1], worker, args.lease)
+                finished += 1
+                continue
+            if manifest.requeue_stale(args.lease):
+                continue
+            if args.no_wait or manifest.counts()["running"] == 0:
+                return finished
+            # Jobs still run elsewhere; wait in case one of them comes back to the queue.
+            time.sleep(min(args.lease / 4, 10.0))
+
+    print(f"Worker {worker_base}: {args.jobs} slots on {manifest.root}", flush=True)
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        finished = sum(pool.map(loop, range(args.jobs)))
+    counts = manifest.counts()
+    print(f"Worker {worker_base}: ran {finished} jobs; {counts['done']} done, {counts['failed']} failed in the manifest")
+    sys.exit(1 if counts["failed"] else 0)
+
+
+def status(args: argparse.Namespace) -> None:
+    manifest = Manifest(args.manifest.resolve())
+    if args.list:
+        # name<TAB>seconds (done) or name<TAB>last result (failed), for shell scripts
+        for entry in sorted(manifest.path(args.list).glob("*.json")):
+            job = json.loads(entry.read_text(encoding="utf-8"))
+            last = job.get("history", [{}])[-1]
+            print(f"{job['name']}\t{last.get('seconds', '') if args.list == 'done' else last.get('result', '')}")
+        return
+    counts = manifest.counts()
+    print(", ".join(f"{count} {state}" for state, count in counts.items()))
+    now = time.time()
+    for claimed in sorted(manifest.path("running").iterdir()):
+        if claimed.name.startswith("."):
+            continue
+        queue_name, _, worker = claimed.name.partition("@")
+        name = queue_name.split(".", 1)[1].rsplit(".json", 1)[0]  # 000042.<name>.json
+        print(f"  running  {name} on {worker} (alive {now - claimed.stat().st_mtime:.0f} s ago)")
+    for failed in sorted(manifest.path("failed").glob("*.json")):
+        job = json.loads(failed.read_text(encoding="utf-8"))
+        print(f"  FAILED   {job['name']}: {', '.join(attempt['result'] for attempt in job.get('history', []))}")
+
+
+def build_parser() -> argparse.ArgumentParser:
+    script_dir = Path(__file__).resolve().parent
+    parser = argparse.ArgumentParser(description="Run scenario_coex jobs from a shared manifest directory.")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    submit_parser = commands.add_parser("submit", help="Create or extend a manifest (coordinator)")
+    submit_parser.add_argument("--manifest", type=Path, required=True, help="Manifest directory (shared by all nodes)")
+    submit_parser.add_argument(
+        "--jobs",
+        type=Path,
+        action="append",
+        help='JSON lines {"name": ..., "args": [...]}, e.g. an adaptive_sweep batch ("-": stdin)',
+    )
+    submit_parser.add_argument("--scenario", nargs="+", help="Preset names to queue as jobs")
+    submit_parser.add_argument("--args", default="", help="scenario_coex options added to every --scenario job")
+    submit_parser.add_argument("--project-root", type=Path, default=script_dir, help="ns-3 root (default: %(default)s)")
+    submit_parser.add_argument("--log-dir", type=Path, help="Job logs (default: <manifest>/logs)")
+    submit_parser.add_argument("--timeout", type=float, default=0, help="Seconds before a job is killed (0: none)")
+    submit_parser.add_argument("--attempts", type=int, default=3, help="Runs of a job before it counts as failed")
+    submit_parser.add_argument("--fresh", action="store_true", help="Drop all jobs of an existing manifest first")
+    submit_parser.set_defaults(handler=submit)
+
+    work_parser = commands.add_parser("work", help="Claim and run jobs until the manifest is drained")
+    work_parser.add_argument("--manifest", type=Path, required=True, help="Manifest directory")
+    work_parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count() or 1, help="Parallel jobs on this node")
+    work_parser.add_argument(
+        "--lease",
+        type=float,
+        default=120.0,
+        help="Seconds without a heartbeat before a claimed job is given to another worker (default: %(default)s)",
+    )
+    work_parser.add_argument("--worker-id", help="Name of this worker in claims (default: <host>-<pid>)")
+    work_parser.add_argument("--no-wait", action="store_true", help="Exit when the queue is empty, even if jobs still run")
+    work_parser.set_defaults(handler=work)
+
+    status_parser = commands.add_parser("status", help="Show the state of a manifest")
+    status_parser.add_argument("--manifest", type=Path, required=True, help="Manifest directory")
+    status_parser.add_argument("--list", choices=["done", "failed"], help="Only list these jobs, tab-separated")
+    status_parser.set_defaults(handler=status)
+    return parser
+
+
+def main() -> None:
+    args = build_parser().parse_args()
+    args.handler(args)
+
+
+if __name__ == "__main__":
+    main()